@@ -25,6 +25,8 @@
 
 #include <encoders/MatrixSDREncoder.hpp>
 
+#include <cstring> // memcpy
+
 namespace mic {
 namespace encoders {
 
@@ -68,6 +70,24 @@ public:
         return sdr;
     }
 
+	/*!
+	 * @brief Method responsible for encoding batch of matrices into a preallocated matrix of SDRs - copies every matrix into a column, without any temporary matrices.
+	 * @param[in] batch_ Vector of shared pointers containing samples
+	 * @param[out] sdrs_ Matrix containing several SDRs (resized only if its size does not match).
+	 */
+    virtual void encodeBatch(const std::vector<mic::types::MatrixPtr<T> >& batch_, mic::types::Matrix<T>& sdrs_) {
+        // Resize the matrix - noop if the size is correct.
+        sdrs_.resize(sdr_length, batch_.size());
+        T* sdrs_ptr = sdrs_.data();
+
+#pragma omp parallel for if(mic::types::useParallel(batch_.size() * sdr_length))
+        for (size_t i=0; i < batch_.size(); i++ ) {
+            // Matrices are column-major, so the whole sample block is the column.
+            assert((size_t)batch_[i]->size() == sdr_length);
+            memcpy(sdrs_ptr + i * sdr_length, batch_[i]->data(), sdr_length * sizeof(T));
+        }//: for
+    }
+
 	/*!
 	 * Method responsible for decoding of SDR into data.
 	 * @param[in] sdr_ Shared pointer to SDR (1D matrix).
@@ -83,6 +103,9 @@ public:
         return decoded;
     }
 
+	// Unhide the overloaded encodeBatch method.
+	using MatrixSDREncoder<mic::types::Matrix<T>, T>::encodeBatch;
+
 protected:
 	/// Height of the matrix - number of rows.
 	size_t matrix_height;
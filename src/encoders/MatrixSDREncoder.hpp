@@ -65,17 +65,33 @@ public:
 		// Create returned matrix.
         std::shared_ptr<mic::types::Matrix<outputDataType> > sdrs (new mic::types::Matrix<outputDataType> (sdr_length, batch_.size()));
 
+		// Encode the samples.
+		this->encodeBatch(batch_, *sdrs);
+
+		// Return the matrix containing SDRs.
+		return sdrs;
+	}
+
+
+	/*!
+	 * Method responsible for encoding batch containing several samples into a preallocated matrix containing several SDRs (one per column).
+	 * The matrix is resized only if its size does not match, so it can be reused across iterations.
+	 * The default implementation encodes the samples one by one - derived classes should override it with an allocation-free variant.
+	 * @param[in] batch_ Vector of shared pointers containing samples
+	 * @param[out] sdrs_ Matrix containing several SDRs.
+	 */
+    virtual void encodeBatch(const std::vector<std::shared_ptr<inputDataType> >& batch_, mic::types::Matrix<outputDataType>& sdrs_) {
+		// Resize the matrix - noop if the size is correct.
+		sdrs_.resize(sdr_length, batch_.size());
+
 		// Encode the samples one by one.
 		for (size_t i=0; i < batch_.size(); i++ ) {
 			// Encode single sample.
             std::shared_ptr<mic::types::Matrix<outputDataType> > sample_sdr = this->encodeSample(batch_[i]);
 
 			// Set SDR rows.
-			sdrs->col(i) = sample_sdr->col(0);
+			sdrs_.col(i) = sample_sdr->col(0);
 		}//: for
-
-		// Return the matrix containing SDRs.
-		return sdrs;
 	}
 
 
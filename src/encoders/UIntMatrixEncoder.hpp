@@ -75,6 +75,27 @@ public:
         return sdr;
     }
 
+	/*!
+	 * @brief Method responsible for encoding batch of unsigned integers into a preallocated matrix of SDRs (1-of-k), without any temporary matrices.
+	 * @param[in] batch_ Vector of shared pointers to unsigned ints.
+	 * @param[out] sdrs_ Matrix containing several SDRs (resized only if its size does not match).
+	 */
+    virtual void encodeBatch(const std::vector<std::shared_ptr<unsigned int> >& batch_, mic::types::Matrix<T>& sdrs_) {
+        // Resize the matrix - noop if the size is correct.
+        sdrs_.resize(sdr_length, batch_.size());
+        // Set all zeros.
+        sdrs_.setZero();
+
+        for (size_t i=0; i < batch_.size(); i++ ) {
+            unsigned int index = (*batch_[i]);
+
+            if (index >= sdr_length)
+                LOG(LERROR) << "The SDR is too short for proper encoding of "<<index<<"!";
+            else
+                sdrs_(index, i) = 1;
+        }//: for
+    }
+
 	/*!
 	 * Method responsible for decoding of SDR into data.
 	 * @param[in] sdr_ Shared pointer to SDR.
@@ -95,6 +116,9 @@ public:
         return std::make_shared<unsigned int>(decoded);
     }
 
+	// Unhide the overloaded encodeBatch method.
+	using MatrixSDREncoder<unsigned int, T>::encodeBatch;
+
 private:
     using MatrixSDREncoder<unsigned int, T>::sdr_length;
 };
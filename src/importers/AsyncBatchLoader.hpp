@@ -0,0 +1,287 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file AsyncBatchLoader.hpp
+ * \brief Contains declaration (and definition) of a loader preparing batches of an importer asynchronously, on background threads.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_ASYNCBATCHLOADER_HPP_
+#define SRC_IMPORTERS_ASYNCBATCHLOADER_HPP_
+
+#include <importers/Importer.hpp>
+#include <utils/PrefetchRing.hpp>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <random>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Batch prepared by AsyncBatchLoader.
+ * \author tkornuta
+ * \tparam OutputType Type of the prepared batch.
+ */
+template <typename OutputType>
+struct AsyncBatch {
+	/// Number of the batch (in the order of sampling, counted from 0) - allows to restore the order when there are many workers.
+	size_t number;
+
+	/// Positions of samples of the batch in the importer.
+	std::vector<size_t> positions;
+
+	/// Prepared batch.
+	OutputType output;
+};
+
+
+/*!
+ * \brief Loader wrapping an importer and preparing the next batches on worker threads while the consumer processes the current one.
+ * The sampling (sequential or shuffled - every sample is visited once per epoch) is done under a lock, whereas gathering and preparation
+ * (e.g. packing, normalization, encoding - done by the user-defined function) run in parallel with the consumer.
+ * Prepared batches are stored in a bounded ring, so the number of batches prepared in advance is limited by the queue depth.
+ * Note: the importer must not be modified while the loader is running. With more than one worker the batches might be returned out of order.
+ * \author tkornuta
+ * \tparam DataType Type of the sample data.
+ * \tparam LabelType Type of the sample label.
+ * \tparam OutputType Type of the prepared batch (e.g. a structure containing matrices of inputs and targets).
+ */
+template <typename DataType, typename LabelType, typename OutputType>
+class AsyncBatchLoader {
+public:
+	/// Type of the function preparing the batch - gets the view of samples and the (reused) output.
+	typedef std::function<void(mic::types::BatchView<DataType, LabelType>&, OutputType&)> PrepareFunction;
+
+	/*!
+	 * Constructor. Does not start the workers.
+	 * @param importer_ Importer (with imported data).
+	 * @param batch_size_ Size of the batch.
+	 * @param prepare_ Function preparing the batch.
+	 * @param queue_depth_ Number of batches prepared in advance.
+	 * @param workers_ Number of worker threads.
+	 * @param shuffle_ If set, samples are shuffled at the beginning of every epoch.
+	 */
+	AsyncBatchLoader(mic::importers::Importer<DataType, LabelType>& importer_, size_t batch_size_, PrepareFunction prepare_, size_t queue_depth_ = 2, size_t workers_ = 1, bool shuffle_ = true) :
+		importer(importer_),
+		batch_size(batch_size_),
+		prepare(prepare_),
+		number_of_workers(workers_ > 0 ? workers_ : 1),
+		shuffle(shuffle_),
+		ring(queue_depth_),
+		current(nullptr),
+		next_position(0),
+		epoch(0),
+		sampled_batches(0),
+		running(false),
+		stop_flag(false),
+		rng_mt19937_64(rd())
+	{
+	}
+
+	/*!
+	 * Destructor. Stops the workers.
+	 */
+	~AsyncBatchLoader() {
+		stop();
+	}
+
+	/*!
+	 * Starts the workers - from the beginning of the first epoch.
+	 * @return TRUE if the workers were started, FALSE if the importer is empty.
+	 */
+	bool start() {
+		stop();
+		if (importer.size() == 0)
+			return false;
+		ring.reset();
+		current = nullptr;
+		error = nullptr;
+		stop_flag = false;
+
+		// Initialize the order of samples.
+		order.resize(importer.size());
+		for (size_t i = 0; i < order.size(); i++)
+			order[i] = i;
+		if (shuffle)
+			std::shuffle(order.begin(), order.end(), rng_mt19937_64);
+		next_position = 0;
+		epoch = 0;
+		sampled_batches = 0;
+
+		for (size_t i = 0; i < number_of_workers; i++)
+			workers.push_back(std::thread(&AsyncBatchLoader<DataType, LabelType, OutputType>::work, this));
+		running = true;
+		return true;
+	}
+
+	/*!
+	 * Returns the next prepared batch, waiting if it is not ready yet.
+	 * The batch remains valid (and can be modified in place) until the next call of the method (or stop()).
+	 * If the preparation of a batch threw an exception, the exception is rethrown here.
+	 * @return Pointer to the batch or nullptr if the loader is not running.
+	 */
+	AsyncBatch<OutputType>* getNextBatch() {
+		if (!running)
+			return nullptr;
+		// Return the previous batch to the ring.
+		if (current != nullptr)
+			ring.release(current);
+		current = ring.acquireReady();
+		if ((current == nullptr) && error)
+			std::rethrow_exception(error);
+		return current;
+	}
+
+	/*!
+	 * Stops the workers - wakes them up and waits until they finish.
+	 */
+	void stop() {
+		if (!running)
+			return;
+		stop_flag = true;
+		ring.close();
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+		workers.clear();
+		current = nullptr;
+		running = false;
+	}
+
+	/// Returns the number of the current epoch (counted from 0) of the sampler.
+	size_t getEpoch() {
+		std::lock_guard<std::mutex> lock(sampler_mtx);
+		return epoch;
+	}
+
+protected:
+	/*!
+	 * Fills the positions of the next batch - continues in the next epoch (reshuffled) if the current one is exhausted.
+	 * @param number_ Output number of the batch.
+	 * @param positions_ Output vector of positions.
+	 */
+	void sample(size_t& number_, std::vector<size_t>& positions_) {
+		std::lock_guard<std::mutex> lock(sampler_mtx);
+		number_ = sampled_batches++;
+		positions_.resize(batch_size);
+		for (size_t i = 0; i < batch_size; i++) {
+			if (next_position >= order.size()) {
+				// Start a new epoch.
+				if (shuffle)
+					std::shuffle(order.begin(), order.end(), rng_mt19937_64);
+				next_position = 0;
+				epoch++;
+			}//: if
+			positions_[i] = order[next_position++];
+		}//: for
+	}
+
+	/*!
+	 * Body of a worker thread.
+	 */
+	void work() {
+		try {
+			while (!stop_flag) {
+				AsyncBatch<OutputType>* batch = ring.acquireFree();
+				if (batch == nullptr)
+					return;
+				sample(batch->number, batch->positions);
+				// Gather and prepare.
+				mic::types::BatchView<DataType, LabelType> view = importer.getBatchView(batch->positions);
+				prepare(view, batch->output);
+				ring.publish(batch);
+			}//: while
+		} catch (...) {
+			// Pass the exception to the consumer.
+			{
+				std::lock_guard<std::mutex> lock(sampler_mtx);
+				if (!error)
+					error = std::current_exception();
+			}
+			ring.close();
+		}//: catch
+	}
+
+	/// Wrapped importer.
+	mic::importers::Importer<DataType, LabelType>& importer;
+
+	/// Size of the batch.
+	size_t batch_size;
+
+	/// Function preparing batches.
+	PrepareFunction prepare;
+
+	/// Number of worker threads.
+	size_t number_of_workers;
+
+	/// Flag denoting whether samples are shuffled.
+	bool shuffle;
+
+	/// Ring of prepared batches.
+	mic::utils::PrefetchRing<AsyncBatch<OutputType> > ring;
+
+	/// Batch currently used by the consumer.
+	AsyncBatch<OutputType>* current;
+
+	/// Worker threads.
+	std::vector<std::thread> workers;
+
+	/// Order of samples in the current epoch.
+	std::vector<size_t> order;
+
+	/// Position of the next sample in the current epoch.
+	size_t next_position;
+
+	/// Number of the current epoch.
+	size_t epoch;
+
+	/// Number of batches sampled since start.
+	size_t sampled_batches;
+
+	/// Mutex protecting the sampler (and error).
+	std::mutex sampler_mtx;
+
+	/// Exception thrown by a worker.
+	std::exception_ptr error;
+
+	/// Flag denoting that the workers are running.
+	bool running;
+
+	/// Flag stopping the workers.
+	std::atomic<bool> stop_flag;
+
+	/*!
+	 * Random device used for generation of random numbers.
+	 */
+	std::random_device rd;
+
+	/*!
+	 *  Mersenne Twister pseudo-random generator of 64-bit numbers.
+	 */
+	std::mt19937_64 rng_mt19937_64;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_ASYNCBATCHLOADER_HPP_ */
@@ -0,0 +1,206 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: AsyncBatchLoaderTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include <importers/AsyncBatchLoader.hpp>
+
+/*!
+ * \brief Importer of N synthetic <int, unsigned int> samples - sample i has data i and label i%10.
+ */
+class SyntheticImporter : public mic::importers::Importer<int, unsigned int> {
+public:
+	SyntheticImporter(size_t samples_) : Importer("synthetic_importer"), number_of_samples(samples_) { }
+
+	bool importData() {
+		for (size_t i = 0; i < number_of_samples; i++)
+			add(std::make_shared<int>(i), std::make_shared<unsigned int>(i%10));
+		return true;
+	}
+
+	void initializePropertyDependentVariables() { }
+
+private:
+	size_t number_of_samples;
+};
+
+/// Loader returning the data of samples.
+typedef mic::importers::AsyncBatchLoader<int, unsigned int, std::vector<int> > SyntheticLoader;
+
+/*!
+ * Copies data of samples of the view into the output.
+ */
+void copyData(mic::types::BatchView<int, unsigned int>& view_, std::vector<int>& output_) {
+	output_.resize(view_.size());
+	for (size_t i = 0; i < view_.size(); i++)
+		output_[i] = *view_.data(i);
+}
+
+/*!
+ * Waits (up to a second) until the counter reaches the expected value.
+ */
+bool waitFor(std::atomic<size_t>& counter_, size_t expected_) {
+	for (size_t i = 0; (i < 1000) && (counter_ < expected_); i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	return (counter_ >= expected_);
+}
+
+
+/*!
+ * Tests whether the number of batches prepared in advance is limited by the queue depth.
+ */
+TEST(AsyncBatchLoader, QueueDepth) {
+	SyntheticImporter importer(100);
+	importer.importData();
+	std::atomic<size_t> prepared(0);
+	SyntheticLoader loader(importer, 5, [&prepared](mic::types::BatchView<int, unsigned int>& view_, std::vector<int>& output_) {
+		copyData(view_, output_);
+		prepared++;
+	}, 3, 2);
+	ASSERT_TRUE(loader.start());
+
+	// Workers fill the whole queue and stop.
+	ASSERT_TRUE(waitFor(prepared, 3));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	ASSERT_EQ(prepared, 3);
+
+	// The consumer holds one batch - there are still no free slots.
+	ASSERT_NE(loader.getNextBatch(), nullptr);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	ASSERT_EQ(prepared, 3);
+
+	// Releasing the batch frees one slot.
+	ASSERT_NE(loader.getNextBatch(), nullptr);
+	ASSERT_TRUE(waitFor(prepared, 4));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	ASSERT_EQ(prepared, 4);
+}
+
+
+/*!
+ * Tests whether every sample is visited exactly once per epoch - also when batches are prepared by many workers (thus out of order).
+ */
+TEST(AsyncBatchLoader, FullEpoch) {
+	const size_t N = 60, batch_size = 4, batches = N / batch_size;
+	SyntheticImporter importer(N);
+	importer.importData();
+	for (size_t workers : {1, 4}) {
+		SyntheticLoader loader(importer, batch_size, copyData, 3, workers, true);
+		ASSERT_TRUE(loader.start());
+
+		// Collect batches of the first two epochs.
+		std::vector<size_t> visits(2 * N, 0);
+		std::vector<bool> received(2 * batches, false);
+		size_t missing = 2 * batches;
+		while (missing > 0) {
+			mic::importers::AsyncBatch<std::vector<int> >* batch = loader.getNextBatch();
+			ASSERT_NE(batch, nullptr);
+			ASSERT_EQ(batch->positions.size(), batch_size);
+			ASSERT_EQ(batch->output.size(), batch_size);
+			if (batch->number >= 2 * batches)
+				continue;
+			ASSERT_FALSE(received[batch->number]);
+			received[batch->number] = true;
+			missing--;
+			const size_t epoch = batch->number / batches;
+			for (size_t i = 0; i < batch_size; i++) {
+				ASSERT_EQ((size_t)batch->output[i], batch->positions[i]);
+				visits[epoch * N + batch->positions[i]]++;
+			}//: for
+		}//: while
+		for (size_t v : visits)
+			ASSERT_EQ(v, 1);
+		ASSERT_GE(loader.getEpoch(), 1);
+	}//: for
+}
+
+
+/*!
+ * Tests whether an exception thrown while preparing a batch is rethrown to the consumer (after the batches prepared before).
+ */
+TEST(AsyncBatchLoader, ExceptionPropagation) {
+	SyntheticImporter importer(20);
+	importer.importData();
+	std::atomic<size_t> prepared(0);
+	SyntheticLoader loader(importer, 2, [&prepared](mic::types::BatchView<int, unsigned int>& view_, std::vector<int>& output_) {
+		if (prepared == 2)
+			throw std::runtime_error("Preparation failed!");
+		copyData(view_, output_);
+		prepared++;
+	}, 4, 1, false);
+	ASSERT_TRUE(loader.start());
+
+	ASSERT_EQ(loader.getNextBatch()->output[0], 0);
+	ASSERT_EQ(loader.getNextBatch()->output[0], 2);
+	ASSERT_THROW(loader.getNextBatch(), std::runtime_error);
+
+	// Can be restarted.
+	loader.stop();
+	prepared = 0;
+	ASSERT_TRUE(loader.start());
+	ASSERT_NE(loader.getNextBatch(), nullptr);
+}
+
+
+/*!
+ * Tests whether the loader can be stopped (and destroyed) while workers are preparing batches.
+ */
+TEST(AsyncBatchLoader, DestroyWhileBusy) {
+	SyntheticImporter importer(100);
+	importer.importData();
+	std::atomic<size_t> started(0);
+	auto slow_copy = [&started](mic::types::BatchView<int, unsigned int>& view_, std::vector<int>& output_) {
+		started++;
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		copyData(view_, output_);
+	};
+	{
+		SyntheticLoader loader(importer, 5, slow_copy, 2, 4);
+		ASSERT_TRUE(loader.start());
+		// Destroyed while all workers are busy.
+		ASSERT_TRUE(waitFor(started, 2));
+	}
+	{
+		SyntheticLoader loader(importer, 5, slow_copy, 2, 4);
+		ASSERT_TRUE(loader.start());
+		// Destroyed while the consumer holds a batch and workers wait or prepare the next ones.
+		ASSERT_NE(loader.getNextBatch(), nullptr);
+	}
+	// Empty importer cannot be loaded.
+	SyntheticImporter empty(0);
+	SyntheticLoader loader(empty, 5, copyData);
+	ASSERT_FALSE(loader.start());
+	ASSERT_EQ(loader.getNextBatch(), nullptr);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
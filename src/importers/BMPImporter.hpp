@@ -27,6 +27,7 @@
 
 #include <importers/Importer.hpp>
 #include <types/TensorTypes.hpp>
+#include <importers/PixelKernels.hpp>
 
 namespace mic {
 namespace importers {
@@ -192,31 +193,10 @@ public:
 		    // Get data.
 		    float* data_ptr = ptr->data();
 
-		    // Iterate through rows...
-		    for (size_t h =0; h < biHeight; h++){
-		    	// ... and cols.
-		        for (size_t w =0; w < padWidth; w+=img_channels) {
-		        	 // Skip the padding.
-		        	 if (w >= img_channels*biWidth) {
-		        		 continue;
-		        	 }
-		        	size_t i = h*padWidth + w;
-		 	    	/*std::cout << "h = " << h << "w = " << w << "i = " << i ;
-		 	        std::cout << " R: " << int(img[i+2] & 0xff) << " G: " << int(img[i+1] & 0xff) << " B: " << int(img[i] & 0xff)
-		 	        	<< std::endl;*/
-
-		        	// Red
-		           	//(*ptr)({biHeight-1 - h,w/3,0}) = (int(img[i + 2] & 0xff)) / (255.0);
-		        	data_ptr[(biHeight-1 - h)*biWidth + w/img_channels] = (int(img[i + roff] & 0xff)) / (255.0);
-		           	// Green
-		           	//(*ptr)({biHeight-1 - h,w/3,1}) = (int(img[i + 1] & 0xff)) / (255.0);
-		        	data_ptr[(biHeight-1 - h)*biWidth + w/img_channels + 1*biWidth*biHeight] = (int(img[i + goff] & 0xff)) / (255.0);
-		           	// Blue
-		           	//(*ptr)({biHeight-1 - h,w/3,2}) = (int(img[i] & 0xff)) / (255.0);
-		        	data_ptr[(biHeight-1 - h)*biWidth + w/img_channels + 2*biWidth*biHeight] = (int(img[i + boff] & 0xff)) / (255.0);
-
-		        }
-		    }
+		    // Rows are stored bottom-up, pixels are interleaved (BGR or xBGR) - convert every row into planar RGB.
+		    const size_t offsets[3] = {roff, goff, boff};
+		    for (size_t h =0; h < biHeight; h++)
+		    	mic::importers::interleavedToPlanar((const uint8_t*)img.data() + h*padWidth, biWidth, img_channels, offsets, 3, data_ptr + (biHeight-1 - h)*biWidth, (size_t)biWidth*biHeight);
 
 	    //std::cout << " ptr = " << (*ptr) << std::endl;
 	    return ptr;
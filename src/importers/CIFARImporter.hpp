@@ -28,6 +28,9 @@
 
 #include <importers/Importer.hpp>
 #include <types/TensorTypes.hpp>
+#include <importers/PixelKernels.hpp>
+#include <types/SampleArena.hpp>
+#include <fstream>
 
 namespace mic {
 namespace importers {
@@ -84,6 +87,61 @@ public:
 	 * @return TRUE if data loaded successfully, FALSE otherwise.
 	 */
 	bool importData() {
+		bool ok = importSamples([this](unsigned int label_) -> eT* {
+			// Create new tensor of CIFAR image size.
+			mic::types::TensorPtr<eT> ptr = MAKE_TENSOR_PTR(eT, image_height, image_width, image_depth);
+			sample_data.push_back(ptr);
+			sample_labels.push_back(std::make_shared <unsigned int> (label_) );
+			return ptr->data();
+		});
+		if (!ok)
+			return false;
+
+		// Fill the indices table(!)
+		for (size_t i=0; i < sample_data.size(); i++ )
+			sample_indices.push_back(i);
+
+		// Count (and set) number of classes.
+		countClasses();
+
+		LOG(LINFO) << "Data import finished";
+		return true;
+	}
+
+	/*!
+	 * Imports the CIFAR dataset into an arena - images are decoded straight into the slab, so there are no per-sample allocations.
+	 * The arena is reset to the shape of images (height x width x depth, the same layout as tensors returned by importData()). Samples of the importer (batch) are not modified.
+	 * @param arena_ Destination arena.
+	 * @return TRUE if data loaded successfully, FALSE otherwise.
+	 */
+	bool importData(mic::types::SampleArena<eT, unsigned int>& arena_) {
+		arena_ = mic::types::SampleArena<eT, unsigned int>({image_height, image_width, image_depth});
+		return importSamples([&arena_](unsigned int label_) { return arena_.add(label_); });
+	}
+
+	/*!
+	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
+	 */
+	virtual void initializePropertyDependentVariables() { };
+
+protected:
+	// Unhide the fields inherited from the template class Layer via "using" statement.
+    using Importer< mic::types::Tensor<eT>, unsigned int >::registerProperty;
+    using Importer< mic::types::Tensor<eT>, unsigned int >::sample_data;
+    using Importer< mic::types::Tensor<eT>, unsigned int >::sample_labels;
+    using Importer< mic::types::Tensor<eT>, unsigned int >::sample_indices;
+    using Importer< mic::types::Tensor<eT>, unsigned int >::number_of_classes;
+    using Importer< mic::types::Tensor<eT>, unsigned int >::countClasses;
+
+private:
+	/*!
+	 * Reads samples from CIFAR files and decodes images into memory returned by a sink.
+	 * @tparam Sink Type of the sink - callable eT*(unsigned int label) returning memory for (image_height x image_width x image_depth) elements.
+	 * @param sink_ Sink.
+	 * @return TRUE if data loaded successfully, FALSE otherwise.
+	 */
+	template<typename Sink>
+	bool importSamples(Sink sink_) {
 		// Split filename using a semicolon (;) separator.
 	    std::vector<std::string> names_array;
 	    std::size_t pos = 0, found;
@@ -97,6 +155,7 @@ public:
 	    names_array.push_back(std::string(data_filename).substr(pos));
 
 	    // Buffer.
+	    size_t imported = 0;
 		char buffer[image_height*image_width*image_depth];
 
 	    // Read data from files.
@@ -144,70 +203,25 @@ public:
 	    		if ((min_sample > 0) && (sample < (size_t)min_sample))
 	    			continue;
 
-	    		// Create new tensor of CIFAR image size.
-	    		mic::types::TensorPtr<eT> ptr = MAKE_TENSOR_PTR(eT, image_height, image_width, image_depth);
-	    		eT* data = ptr->data();
-
-	    		// Copy image.
-				for (size_t id = 0; id < image_depth; ++id) {
-					for (size_t ih = 0; ih < image_height; ++ih) {
-						for (size_t iw = 0; iw < image_width; ++iw) {
-							// Calculate indices.
-							// BI - row-major.
-							size_t bi = id*image_height*image_width + ih*image_width + iw;
-							// DI - col-major.
-							//size_t di = id*image_height*image_width + ih + iw*image_height;
-
-							// Copy value.
-			    			data[bi] = (eT)((uint8_t)buffer[bi])/255.0f;
-						}
-					}//: width
-				}//: depth
-	    		/*for (size_t i = 0; i < (size_t)(image_width*image_height*image_depth); i++) {
-	    			data[i] = (eT)((uint8_t)buffer[i])/255.0f;
-	    		}//: for*/
-
-	    		sample_data.push_back(ptr);
-	    		sample_labels.push_back(std::make_shared <unsigned int> (temp_label) );
+	    		// Copy image - the layout of tensor is the same as the one of file (planes of row-major channels).
+	    		mic::importers::u8ToReal((const uint8_t*)buffer, sink_(temp_label), image_height*image_width*image_depth);
+	    		imported++;
 
 	    		// Check limit.
 	    		if ((max_sample > 0) && (sample >= (size_t)max_sample))
 	    			break;
 	    	}//: while !eof
 
-	    	LOG(LINFO) << "Imported " << sample_data.size() << " samples";
+	    	LOG(LINFO) << "Imported " << imported << " samples";
 
 			// Close files
 			cifar_file.close();
 
 		}//: for files.
 
-		// Fill the indices table(!)
-		for (size_t i=0; i < sample_data.size(); i++ )
-			sample_indices.push_back(i);
-
-		// Count (and set) number of classes.
-		countClasses();
-
-		LOG(LINFO) << "Data import finished";
 		return true;
 	}
 
-	/*!
-	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
-	 */
-	virtual void initializePropertyDependentVariables() { };
-
-protected:
-	// Unhide the fields inherited from the template class Layer via "using" statement.
-    using Importer< mic::types::Tensor<eT>, unsigned int >::registerProperty;
-    using Importer< mic::types::Tensor<eT>, unsigned int >::sample_data;
-    using Importer< mic::types::Tensor<eT>, unsigned int >::sample_labels;
-    using Importer< mic::types::Tensor<eT>, unsigned int >::sample_indices;
-    using Importer< mic::types::Tensor<eT>, unsigned int >::number_of_classes;
-    using Importer< mic::types::Tensor<eT>, unsigned int >::countClasses;
-
-private:
 	/*!
 	 * Height of CIFAR image.
 	 */
@@ -0,0 +1,197 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: CIFARImportersTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+#include <importers/CIFARImporter.hpp>
+#include <importers/CIFARStreamImporter.hpp>
+
+/// Size of CIFAR image (32 x 32 x 3).
+const size_t CIFAR_IMAGE_SIZE = 32 * 32 * 3;
+
+/*!
+ * Writes a (synthetic) CIFAR file - records <label><3072 x pixel>, pixel p of record r equal to (first_ + r + p) % 256, label (first_ + r) % 10.
+ * @param filename_ Name of the file.
+ * @param first_ Number of the first record (used to make contents of files different).
+ * @param records_ Number of records.
+ */
+void writeSyntheticCIFAR(const std::string& filename_, size_t first_, size_t records_) {
+	std::ofstream ofs(filename_, std::ios::binary);
+	std::vector<uint8_t> record(CIFAR_IMAGE_SIZE + 1);
+	for (size_t r = first_; r < first_ + records_; r++) {
+		record[0] = r % 10;
+		for (size_t p = 0; p < CIFAR_IMAGE_SIZE; p++)
+			record[p + 1] = (uint8_t)(r + p);
+		ofs.write((const char*)record.data(), record.size());
+	}//: for
+}
+
+
+/*!
+ * Tests whether import into an arena gives the same samples as the import into a batch.
+ */
+TEST(CIFARImporter, ImportIntoArena) {
+	writeSyntheticCIFAR("test-cifar-0.bin", 0, 3);
+	writeSyntheticCIFAR("test-cifar-1.bin", 3, 2);
+	mic::importers::CIFARImporter<float> importer("cifar", "test-cifar-0.bin;test-cifar-1.bin");
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 5);
+
+	mic::types::SampleArena<float, unsigned int> arena;
+	ASSERT_TRUE(importer.importData(arena));
+	ASSERT_EQ(arena.size(), 5);
+	ASSERT_EQ(arena.dims(), std::vector<size_t>({32, 32, 3}));
+
+	for (size_t i = 0; i < 5; i++) {
+		ASSERT_EQ(arena.label(i), i % 10);
+		ASSERT_EQ(arena.label(i), *importer.labels(i));
+		ASSERT_EQ(memcmp(arena.data(i), importer.data(i)->data(), CIFAR_IMAGE_SIZE * sizeof(float)), 0);
+	}//: for
+	ASSERT_FLOAT_EQ(arena.data(4)[10], 14 / 255.0f);
+}
+
+
+/*!
+ * Checks whether the batch contains consecutive records starting from a given one (modulo number of records - for loop mode).
+ * @param batch_ Batch.
+ * @param first_ Number of the first record.
+ * @param records_ Expected number of records in the batch.
+ * @param modulo_ Number of records in all files.
+ */
+void checkStreamBatch(mic::importers::CIFARStreamBatch<float>* batch_, size_t first_, size_t records_, size_t modulo_) {
+	ASSERT_NE(batch_, nullptr);
+	ASSERT_EQ(batch_->images.dims(), std::vector<size_t>({32, 32, 3, records_}));
+	ASSERT_EQ(batch_->labels.size(), records_);
+	for (size_t i = 0; i < records_; i++) {
+		const size_t r = (first_ + i) % modulo_;
+		ASSERT_EQ(batch_->labels[i], r % 10);
+		const float* image = batch_->images.data() + i * CIFAR_IMAGE_SIZE;
+		ASSERT_FLOAT_EQ(image[0], (float)(r % 256) / 255.0f);
+		ASSERT_FLOAT_EQ(image[CIFAR_IMAGE_SIZE - 1], (float)((r + CIFAR_IMAGE_SIZE - 1) % 256) / 255.0f);
+	}//: for
+}
+
+
+/*!
+ * Tests streaming from many files - a batch spanning the file boundary, the partial last batch and the end of the stream.
+ */
+TEST(CIFARStreamImporter, MultipleFiles) {
+	writeSyntheticCIFAR("test-cifar-0.bin", 0, 3);
+	writeSyntheticCIFAR("test-cifar-1.bin", 3, 2);
+	mic::importers::CIFARStreamImporter<float> importer("cifar_stream", "test-cifar-0.bin;test-cifar-1.bin", 2, 2);
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 5);
+
+	// Compare with images imported by CIFARImporter.
+	mic::importers::CIFARImporter<float> reference("cifar", "test-cifar-0.bin;test-cifar-1.bin");
+	ASSERT_TRUE(reference.importData());
+
+	checkStreamBatch(importer.getNextBatch(), 0, 2, 5);
+	// Spans both files.
+	mic::importers::CIFARStreamBatch<float>* batch = importer.getNextBatch();
+	checkStreamBatch(batch, 2, 2, 5);
+	for (size_t i = 0; i < 2; i++)
+		ASSERT_EQ(memcmp(batch->images.data() + i * CIFAR_IMAGE_SIZE, reference.data(2 + i)->data(), CIFAR_IMAGE_SIZE * sizeof(float)), 0);
+	// Partial.
+	checkStreamBatch(importer.getNextBatch(), 4, 1, 5);
+	// End of the stream.
+	ASSERT_EQ(importer.getNextBatch(), nullptr);
+	ASSERT_EQ(importer.getNextBatch(), nullptr);
+}
+
+
+/*!
+ * Tests whether in the loop mode the stream starts again from the first file (also in the middle of a batch).
+ */
+TEST(CIFARStreamImporter, Loop) {
+	writeSyntheticCIFAR("test-cifar-0.bin", 0, 3);
+	writeSyntheticCIFAR("test-cifar-1.bin", 3, 2);
+	mic::importers::CIFARStreamImporter<float> importer("cifar_stream", "test-cifar-0.bin;test-cifar-1.bin", 2, 2);
+	importer.setLoop(true);
+	ASSERT_TRUE(importer.importData());
+
+	// 3 passes through the data - all batches are full.
+	for (size_t b = 0; b < 8; b++)
+		checkStreamBatch(importer.getNextBatch(), 2 * b, 2, 5);
+
+	importer.stop();
+	ASSERT_EQ(importer.getNextBatch(), nullptr);
+}
+
+
+/*!
+ * Tests whether stop() finishes the background thread blocked while waiting for a free slot of the ring.
+ */
+TEST(CIFARStreamImporter, StopBlockedProducer) {
+	writeSyntheticCIFAR("test-cifar-0.bin", 0, 3);
+	mic::importers::CIFARStreamImporter<float> importer("cifar_stream", "test-cifar-0.bin", 1, 1);
+	importer.setLoop(true);
+	ASSERT_TRUE(importer.importData());
+
+	// The consumer holds the only slot - the producer waits for its release.
+	checkStreamBatch(importer.getNextBatch(), 0, 1, 3);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	importer.stop();
+	ASSERT_EQ(importer.getNextBatch(), nullptr);
+
+	// Can be restarted.
+	ASSERT_TRUE(importer.importData());
+	checkStreamBatch(importer.getNextBatch(), 0, 1, 3);
+}
+
+
+/*!
+ * Tests handling of missing files - both before and after starting the stream.
+ */
+TEST(CIFARStreamImporter, MissingFile) {
+	writeSyntheticCIFAR("test-cifar-0.bin", 0, 3);
+	writeSyntheticCIFAR("test-cifar-1.bin", 3, 2);
+	mic::importers::CIFARStreamImporter<float> importer("cifar_stream", "test-cifar-0.bin;test-cifar-missing.bin", 1, 1);
+	ASSERT_FALSE(importer.importData());
+	ASSERT_EQ(importer.getNextBatch(), nullptr);
+
+	// The second file is removed while the producer waits for the consumer - the stream ends after the first file.
+	importer.setDataFilename("test-cifar-0.bin;test-cifar-1.bin");
+	importer.setLoop(true);
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(std::remove("test-cifar-1.bin"), 0);
+	for (size_t b = 0; b < 3; b++)
+		checkStreamBatch(importer.getNextBatch(), b, 1, 5);
+	ASSERT_EQ(importer.getNextBatch(), nullptr);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
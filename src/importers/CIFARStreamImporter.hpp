@@ -0,0 +1,328 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file CIFARStreamImporter.hpp
+ * \brief Contains declaration (and definition) of a streaming CIFAR importer, reading records in chunks on a background thread.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_CIFARSTREAMIMPORTER_HPP_
+#define SRC_IMPORTERS_CIFARSTREAMIMPORTER_HPP_
+
+#include <logger/Log.hpp>
+#include <configuration/PropertyTree.hpp>
+
+#include <types/Tensor.hpp>
+#include <utils/PrefetchRing.hpp>
+#include <importers/PixelKernels.hpp>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <atomic>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Batch of CIFAR samples prepared by CIFARStreamImporter.
+ * \author tkornuta
+ * \tparam eT Type of elements of the tensor.
+ */
+template <typename eT>
+struct CIFARStreamBatch {
+	/// Images - tensor of size height x width x depth x batch size (every image has the same layout as the ones returned by CIFARImporter).
+	mic::types::Tensor<eT> images;
+
+	/// Labels.
+	std::vector<unsigned int> labels;
+
+	/// Buffer for raw records read from file.
+	std::vector<char> buffer;
+};
+
+
+/*!
+ * \brief Class responsible for streaming CIFAR images - records are read in chunks (one batch at a time) by a background thread into a bounded ring of ready batches.
+ * Hence the memory usage is bounded by the number of prefetched batches and the training can start right after the first chunk was read.
+ * \author tkornuta
+ * \tparam eT Type of elements of the tensor.
+ */
+template <typename eT>
+class CIFARStreamImporter : public mic::configuration::PropertyTree {
+public:
+	/*!
+	 * Constructor. Sets CIFAR image default properties. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 * @param data_filename_ File(s) (with path) containing images. If data is supposed to be loaded from more than one files, they should be separated by a semicolon (;).
+	 * @param batch_size_ Size of the batch.
+	 * @param prefetch_batches_ Number of batches prepared in advance (size of the ring).
+	 */
+	CIFARStreamImporter(std::string node_name_ = "cifar_stream_importer", std::string data_filename_ = "", size_t batch_size_ = 1, size_t prefetch_batches_ = 4)
+		: PropertyTree(node_name_),
+			data_filename("data_filename", data_filename_),
+			batch_size("batch_size", batch_size_),
+			prefetch_batches("prefetch_batches", prefetch_batches_),
+			loop("loop", false),
+			samples(0),
+			ring(nullptr),
+			current(nullptr),
+			stop_flag(false)
+	{
+		// Register properties - so their values can be overridden (read from the configuration file).
+		registerProperty(data_filename);
+		registerProperty(batch_size);
+		registerProperty(prefetch_batches);
+		registerProperty(loop);
+
+		// Set image properties.
+		image_height = 32;
+		image_width = 32;
+		image_depth = 3;
+	}
+
+	/*!
+	 * Virtual destructor. Stops the background thread.
+	 */
+	virtual ~CIFARStreamImporter() {
+		stop();
+	}
+
+	/*!
+	 * Set name and patch of the file/files containing CIFAR images.
+	 * @param data_filename_ File (with path) containing CIFAR images. If data is supposed to be loaded from more than one files, they should be separated by a semicolon (;).
+	 */
+	void setDataFilename(std::string data_filename_) {
+		data_filename = data_filename_;
+	}
+
+	/*!
+	 * Sets whether the stream should start again from the first file after reaching the end of the last one.
+	 * @param loop_ Loop flag.
+	 */
+	void setLoop(bool loop_) {
+		loop = loop_;
+	}
+
+	/*!
+	 * Checks the files and starts the background thread - does not wait for any data.
+	 * @return TRUE if all files exist, FALSE otherwise.
+	 */
+	bool importData() {
+		stop();
+
+		// Split filename using a semicolon (;) separator.
+		names_array.clear();
+		std::string names = data_filename;
+		std::size_t pos = 0, found;
+		while((found = names.find_first_of(';', pos)) != std::string::npos) {
+			names_array.push_back(names.substr(pos, found - pos));
+			pos = found+1;
+		}//: while
+		names_array.push_back(names.substr(pos));
+
+		// Check files and count samples.
+		samples = 0;
+		for (size_t fi = 0; fi < names_array.size(); ++fi) {
+			std::ifstream cifar_file(names_array[fi], std::ios::in | std::ios::binary | std::ios::ate);
+			if (!cifar_file.is_open()) {
+				LOG(LFATAL) << "Oops! Couldn't find file: " << names_array[fi];
+				return false;
+			}//: if
+			samples += (size_t)cifar_file.tellg() / recordSize();
+		}//: for
+		LOG(LINFO) << "Streaming " << samples << " CIFAR samples from " << names_array.size() << " file(s)";
+
+		// Create the ring and start the background thread.
+		ring = new mic::utils::PrefetchRing<CIFARStreamBatch<eT> >(prefetch_batches);
+		stop_flag = false;
+		worker = std::thread(&CIFARStreamImporter<eT>::stream, this);
+		return true;
+	}
+
+	/*!
+	 * Returns the next batch prepared by the background thread, waiting if it is not ready yet.
+	 * The batch remains valid (and can be modified in place) until the next call of the method (or stop()). The last batch might be smaller than the batch size.
+	 * @return Pointer to the batch or nullptr if the stream has ended.
+	 */
+	CIFARStreamBatch<eT>* getNextBatch() {
+		if (ring == nullptr)
+			return nullptr;
+		// Return the previous batch to the ring.
+		if (current != nullptr)
+			ring->release(current);
+		current = ring->acquireReady();
+		return current;
+	}
+
+	/*!
+	 * Stops the background thread and frees the prefetched batches.
+	 */
+	void stop() {
+		if (ring == nullptr)
+			return;
+		stop_flag = true;
+		ring->close();
+		if (worker.joinable())
+			worker.join();
+		delete ring;
+		ring = nullptr;
+		current = nullptr;
+	}
+
+	/*!
+	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
+	 */
+	virtual void initializePropertyDependentVariables() { };
+
+	/// Returns the number of samples in all files (in a single pass).
+	size_t size() const {
+		return samples;
+	}
+
+	/// Returns the number of classes.
+	size_t classes() const {
+		return 10;
+	}
+
+protected:
+	/// Returns size of the record - <1 x label><3072 x pixel>.
+	size_t recordSize() const {
+		return 1 + image_height * image_width * image_depth;
+	}
+
+	/*!
+	 * Body of the background thread - reads records in chunks of batch size and converts them into batches.
+	 * A batch can span file boundaries.
+	 */
+	void stream() {
+		const size_t record_size = recordSize();
+		const size_t image_size = record_size - 1;
+		size_t fi = 0;
+		std::ifstream cifar_file;
+		bool end_of_stream = false;
+
+		do {
+			CIFARStreamBatch<eT>* batch = ring->acquireFree();
+			if (batch == nullptr)
+				return;
+			batch->buffer.resize(batch_size * record_size);
+
+			// Read records - one read per chunk.
+			size_t records = 0;
+			while ((records < batch_size) && !stop_flag) {
+				if (!cifar_file.is_open()) {
+					// All files read.
+					if (fi >= names_array.size()) {
+						if (!loop || (samples == 0)) {
+							end_of_stream = true;
+							break;
+						}//: if
+						fi = 0;
+					}//: if
+					cifar_file.open(names_array[fi++], std::ios::in | std::ios::binary);
+					// The file might have been removed after importData() - end the stream.
+					if (!cifar_file.is_open()) {
+						LOG(LERROR) << "Oops! Couldn't open file: " << names_array[fi-1];
+						end_of_stream = true;
+						break;
+					}//: if
+				}//: if
+				cifar_file.read(batch->buffer.data() + records * record_size, (batch_size - records) * record_size);
+				records += (size_t)cifar_file.gcount() / record_size;
+				if (!cifar_file) {
+					cifar_file.close();
+					cifar_file.clear();
+				}//: if
+			}//: while
+
+			if (records == 0) {
+				// End of the stream.
+				ring->release(batch);
+				break;
+			}//: if
+
+			// Convert records into images and labels.
+			batch->images.resize({image_height, image_width, image_depth, records});
+			batch->labels.resize(records);
+			eT* data = batch->images.data();
+			for (size_t i = 0; i < records; i++) {
+				const uint8_t* record = (const uint8_t*)batch->buffer.data() + i * record_size;
+				batch->labels[i] = record[0];
+				mic::importers::u8ToReal(record + 1, data + i * image_size, image_size);
+			}//: for
+
+			ring->publish(batch);
+		} while (!stop_flag && !end_of_stream);
+
+		// Let the consumer know that there will be no more batches.
+		ring->close();
+	}
+
+	/*!
+	 * Property: directory/Name of file containing images (binary datafile).
+	 */
+	mic::configuration::Property<std::string> data_filename;
+
+	/*!
+	 * Property: size of the batch.
+	 */
+	mic::configuration::Property<size_t> batch_size;
+
+	/*!
+	 * Property: number of batches prepared in advance.
+	 */
+	mic::configuration::Property<size_t> prefetch_batches;
+
+	/*!
+	 * Property: if set, the stream starts again from the first file after reaching the end of the last one.
+	 */
+	mic::configuration::Property<bool> loop;
+
+	/// Height of CIFAR image.
+	size_t image_height;
+
+	/// Width of CIFAR image.
+	size_t image_width;
+
+	/// Depth of CIFAR image.
+	size_t image_depth;
+
+	/// Names of files.
+	std::vector<std::string> names_array;
+
+	/// Number of samples in all files.
+	size_t samples;
+
+	/// Ring of prefetched batches.
+	mic::utils::PrefetchRing<CIFARStreamBatch<eT> >* ring;
+
+	/// Batch currently used by the consumer.
+	CIFARStreamBatch<eT>* current;
+
+	/// Background thread.
+	std::thread worker;
+
+	/// Flag stopping the background thread.
+	std::atomic<bool> stop_flag;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_CIFARSTREAMIMPORTER_HPP_ */
@@ -0,0 +1,99 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file IdxFile.cpp
+ * \brief Contains definition of methods of a memory-mapped file in the idx format.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#include <importers/IdxFile.hpp>
+
+#include <logger/Log.hpp>
+
+#include <limits>
+
+namespace mic {
+namespace importers {
+
+IdxFile::IdxFile() : item_size(0), payload_ptr(nullptr)
+{
+}
+
+bool IdxFile::open(const std::string& filename_, size_t expected_dims_) {
+	close();
+
+	if (!file.open(filename_)) {
+		LOG(LFATAL) << "Oops! Couldn't open file: " << filename_;
+		return false;
+	}//: if
+
+	const uint8_t* ptr = file.data();
+	// Magic number: 0x00 0x00 <type> <number of dimensions>.
+	if ((file.size() < 4) || (ptr[0] != 0) || (ptr[1] != 0) || (ptr[2] != 0x08)) {
+		LOG(LERROR) << "File " << filename_ << " is not an idx file containing unsigned bytes";
+		close();
+		return false;
+	}//: if
+	if (ptr[3] != expected_dims_) {
+		LOG(LERROR) << "File " << filename_ << " contains " << (unsigned)ptr[3] << " dimensions, expected " << expected_dims_;
+		close();
+		return false;
+	}//: if
+
+	// Read dimensions (big-endian).
+	const size_t header_size = 4 + 4 * expected_dims_;
+	if (file.size() < header_size) {
+		LOG(LERROR) << "File " << filename_ << " is truncated (header)";
+		close();
+		return false;
+	}//: if
+	dimensions.resize(expected_dims_);
+	item_size = 1;
+	for (size_t k = 0; k < expected_dims_; k++) {
+		const uint8_t* d = ptr + 4 + 4 * k;
+		dimensions[k] = ((size_t)d[0] << 24) | ((size_t)d[1] << 16) | ((size_t)d[2] << 8) | (size_t)d[3];
+		if (k > 0) {
+			// Corrupted dimensions might overflow the size of an item.
+			if ((dimensions[k] != 0) && (item_size > std::numeric_limits<size_t>::max() / dimensions[k])) {
+				LOG(LERROR) << "File " << filename_ << " contains invalid dimensions (item size overflows)";
+				close();
+				return false;
+			}//: if
+			item_size *= dimensions[k];
+		}//: if
+	}//: for
+
+	// Check whether the file contains all items (division avoids overflow of count * item_size).
+	if ((item_size > 0) && (count() > (file.size() - header_size) / item_size)) {
+		LOG(LERROR) << "File " << filename_ << " is truncated (expected " << count() << " items of size " << item_size << ")";
+		close();
+		return false;
+	}//: if
+
+	payload_ptr = ptr + header_size;
+	return true;
+}
+
+void IdxFile::close() {
+	file.close();
+	dimensions.clear();
+	item_size = 0;
+	payload_ptr = nullptr;
+}
+
+} /* namespace importers */
+} /* namespace mic */
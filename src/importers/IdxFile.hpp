@@ -0,0 +1,134 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file IdxFile.hpp
+ * \brief Contains declaration of a memory-mapped file in the idx format (used e.g. by MNIST).
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_IDXFILE_HPP_
+#define SRC_IMPORTERS_IDXFILE_HPP_
+
+#include <importers/MappedFile.hpp>
+
+#include <vector>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Memory-mapped file in the idx format containing unsigned bytes (e.g. MNIST images or labels).
+ * The header (magic number: two zero bytes, type 0x08, number of dimensions, followed by big-endian 32-bit sizes of dimensions) is validated while opening.
+ * The 0th dimension is the number of items, the remaining ones are dimensions of a single item.
+ * \author tkornuta
+ */
+class IdxFile {
+public:
+	/*!
+	 * Constructor. Does not open anything.
+	 */
+	IdxFile();
+
+	/*!
+	 * Maps the file and validates its header.
+	 * @param filename_ Name of the file (with path).
+	 * @param expected_dims_ Expected number of dimensions (e.g. 1 for labels, 3 for images).
+	 * @return TRUE if the file was mapped and its header is valid, FALSE otherwise.
+	 */
+	bool open(const std::string& filename_, size_t expected_dims_);
+
+	/*!
+	 * Unmaps the file.
+	 */
+	void close();
+
+	/*!
+	 * Hints the OS about the expected access pattern.
+	 * @param sequential_ TRUE if the items will be read sequentially, FALSE if randomly.
+	 */
+	void advise(bool sequential_) {
+		file.advise(sequential_);
+	}
+
+	/*!
+	 * Returns TRUE if a file is mapped.
+	 */
+	bool isOpen() const {
+		return file.isOpen();
+	}
+
+	/*!
+	 * Returns dimensions read from the header.
+	 */
+	const std::vector<size_t>& dims() const {
+		return dimensions;
+	}
+
+	/*!
+	 * Returns k-th dimension.
+	 */
+	size_t dim(size_t k) const {
+		return dimensions[k];
+	}
+
+	/*!
+	 * Returns the number of items (0th dimension).
+	 */
+	size_t count() const {
+		return dimensions.empty() ? 0 : dimensions[0];
+	}
+
+	/*!
+	 * Returns the size of a single item (in bytes).
+	 */
+	size_t itemSize() const {
+		return item_size;
+	}
+
+	/*!
+	 * Returns pointer to the payload (data following the header).
+	 */
+	const uint8_t* data() const {
+		return payload_ptr;
+	}
+
+	/*!
+	 * Returns pointer to the i-th item - a view, no copy is made.
+	 * @param i_ Index of the item.
+	 */
+	const uint8_t* item(size_t i_) const {
+		return payload_ptr + i_ * item_size;
+	}
+
+private:
+	/// Mapped file.
+	MappedFile file;
+
+	/// Dimensions read from the header.
+	std::vector<size_t> dimensions;
+
+	/// Size of a single item.
+	size_t item_size;
+
+	/// Pointer to the payload.
+	const uint8_t* payload_ptr;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_IDXFILE_HPP_ */
@@ -0,0 +1,404 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: MNISTImportersTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+#include <importers/MNISTMatrixImporter.hpp>
+#include <importers/MNISTMappedImporter.hpp>
+#include <importers/MNISTPatchImporter.hpp>
+#include <importers/MNISTPatchDataset.hpp>
+#include <importers/IdxFile.hpp>
+
+/*!
+ * Writes a (synthetic) idx file containing unsigned bytes.
+ * @param filename_ Name of the file.
+ * @param dims_ Dimensions (0th being the number of items).
+ * @param payload_ Payload.
+ */
+void writeIdx(const char* filename_, const std::vector<uint32_t>& dims_, const std::vector<uint8_t>& payload_) {
+	std::ofstream ofs(filename_, std::ios::binary);
+	const uint8_t magic[4] = {0, 0, 0x08, (uint8_t)dims_.size()};
+	ofs.write((const char*)magic, 4);
+	for (uint32_t d : dims_) {
+		const uint8_t be[4] = {(uint8_t)(d >> 24), (uint8_t)(d >> 16), (uint8_t)(d >> 8), (uint8_t)d};
+		ofs.write((const char*)be, 4);
+	}//: for
+	ofs.write((const char*)payload_.data(), payload_.size());
+}
+
+/*!
+ * Writes synthetic MNIST files - n images (pixel (y,x) of image i equal to (i*height*width + y*width + x) % 256) and labels i%10.
+ * @param n_ Number of images.
+ * @param height_ Height of images (DEFAULT=3).
+ * @param width_ Width of images (DEFAULT=4).
+ */
+void writeSyntheticMNIST(size_t n_, size_t height_ = 3, size_t width_ = 4) {
+	const size_t pixels = height_ * width_;
+	std::vector<uint8_t> images(n_ * pixels), labels(n_);
+	for (size_t i = 0; i < n_; i++) {
+		labels[i] = i % 10;
+		for (size_t p = 0; p < pixels; p++)
+			images[i * pixels + p] = (uint8_t)(i * pixels + p);
+	}//: for
+	writeIdx("test-images.idx", {(uint32_t)n_, (uint32_t)height_, (uint32_t)width_}, images);
+	writeIdx("test-labels.idx", {(uint32_t)n_}, labels);
+}
+
+
+/*!
+ * Tests whether import into an arena gives the same samples as the import into a batch.
+ */
+TEST(MNISTMatrixImporter, ImportIntoArena) {
+	writeSyntheticMNIST(7);
+	mic::importers::MNISTMatrixImporter<float> importer("mnist", "test-images.idx", "test-labels.idx");
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 7);
+
+	mic::types::SampleArena<float, unsigned int> arena;
+	ASSERT_TRUE(importer.importData(arena));
+	ASSERT_EQ(arena.size(), 7);
+	ASSERT_EQ(arena.rows(), 3);
+	ASSERT_EQ(arena.cols(), 4);
+
+	for (size_t i = 0; i < 7; i++) {
+		ASSERT_EQ(arena.label(i), *importer.labels(i));
+		ASSERT_EQ(arena.matrix(i), *importer.data(i));
+	}//: for
+	// Pixel (y=2, x=1) of the 5th image.
+	ASSERT_FLOAT_EQ(arena.matrix(5)(2, 1), (5 * 12 + 2 * 4 + 1) / 255.0f);
+
+	// Batch of consecutive samples - a view of the slab.
+	ASSERT_EQ(arena.batch(2, 3).col(1).data(), arena.data(3));
+
+	// Missing file.
+	importer.setDataFilename("missing.idx");
+	ASSERT_FALSE(importer.importData(arena));
+}
+
+
+/*!
+ * Tests whether the header of a valid idx file is parsed and items are views of the payload.
+ */
+TEST(IdxFile, ValidFile) {
+	writeSyntheticMNIST(5);
+	mic::importers::IdxFile file;
+	ASSERT_TRUE(file.open("test-images.idx", 3));
+	ASSERT_TRUE(file.isOpen());
+	ASSERT_EQ(file.count(), 5);
+	ASSERT_EQ(file.dim(1), 3);
+	ASSERT_EQ(file.dim(2), 4);
+	ASSERT_EQ(file.itemSize(), 12);
+	ASSERT_EQ(file.item(0), file.data());
+	ASSERT_EQ(file.item(4)[7], 4 * 12 + 7);
+
+	file.close();
+	ASSERT_FALSE(file.isOpen());
+	ASSERT_EQ(file.count(), 0);
+}
+
+
+/*!
+ * Tests whether corrupted, truncated and missing files are rejected.
+ */
+TEST(IdxFile, InvalidFiles) {
+	mic::importers::IdxFile file;
+	const std::vector<uint8_t> payload(24, 1);
+
+	// Missing and empty files.
+	ASSERT_FALSE(file.open("test-missing.idx", 3));
+	{ std::ofstream ofs("test-empty.idx", std::ios::binary); }
+	ASSERT_FALSE(file.open("test-empty.idx", 3));
+
+	// Invalid magic number.
+	writeIdx("test-corrupt.idx", {2, 3, 4}, payload);
+	{
+		std::fstream fs("test-corrupt.idx", std::ios::in | std::ios::out | std::ios::binary);
+		fs.put(1);
+	}
+	ASSERT_FALSE(file.open("test-corrupt.idx", 3));
+
+	// Invalid type (0x0D - floats).
+	writeIdx("test-corrupt.idx", {2, 3, 4}, payload);
+	{
+		std::fstream fs("test-corrupt.idx", std::ios::in | std::ios::out | std::ios::binary);
+		fs.seekp(2);
+		fs.put(0x0D);
+	}
+	ASSERT_FALSE(file.open("test-corrupt.idx", 3));
+
+	// Unexpected number of dimensions.
+	writeIdx("test-corrupt.idx", {2, 3, 4}, payload);
+	ASSERT_FALSE(file.open("test-corrupt.idx", 1));
+	ASSERT_TRUE(file.open("test-corrupt.idx", 3));
+
+	// Truncated header - three dimensions declared, only one present.
+	writeIdx("test-truncated.idx", {2}, {});
+	{
+		std::fstream fs("test-truncated.idx", std::ios::in | std::ios::out | std::ios::binary);
+		fs.seekp(3);
+		fs.put(3);
+	}
+	ASSERT_FALSE(file.open("test-truncated.idx", 3));
+
+	// Truncated payload - one byte missing.
+	writeIdx("test-truncated.idx", {2, 3, 4}, std::vector<uint8_t>(23, 1));
+	ASSERT_FALSE(file.open("test-truncated.idx", 3));
+	ASSERT_FALSE(file.isOpen());
+
+	// Dimensions overflowing the size of an item.
+	writeIdx("test-corrupt.idx", {1, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}, payload);
+	ASSERT_FALSE(file.open("test-corrupt.idx", 4));
+	// Number of items exceeding the size of the payload (product overflowing 64 bits).
+	writeIdx("test-corrupt.idx", {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}, payload);
+	ASSERT_FALSE(file.open("test-corrupt.idx", 3));
+}
+
+
+/*!
+ * Tests whether batches materialized from the mapped files are equal to the ones imported by MNISTMatrixImporter.
+ */
+TEST(MNISTMappedImporter, MaterializeBatches) {
+	writeSyntheticMNIST(7);
+	mic::importers::MNISTMatrixImporter<float> reference("mnist", "test-images.idx", "test-labels.idx");
+	ASSERT_TRUE(reference.importData());
+	mic::importers::MNISTMappedImporter<float> importer("mnist_mapped", "test-images.idx", "test-labels.idx", 3);
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 7);
+	ASSERT_EQ(importer.imageHeight(), 3);
+	ASSERT_EQ(importer.imageWidth(), 4);
+
+	// Single samples.
+	for (size_t i = 0; i < 7; i++) {
+		ASSERT_EQ(*importer.getSample(i), *reference.data(i));
+		ASSERT_EQ(importer.label(i), *reference.labels(i));
+	}//: for
+	ASSERT_THROW(importer.getSample(7), std::out_of_range);
+
+	// Consecutive batches - the third one would overflow, so the iteration starts from the beginning.
+	mic::types::Matrix<float> images;
+	std::vector<unsigned int> labels;
+	for (size_t b = 0; b < 3; b++) {
+		importer.getNextBatch(images, labels);
+		const size_t first = (b < 2) ? 3 * b : 0;
+		ASSERT_EQ(images.rows(), 12);
+		ASSERT_EQ(images.cols(), 3);
+		for (size_t i = 0; i < 3; i++) {
+			ASSERT_EQ(labels[i], (first + i) % 10);
+			for (size_t p = 0; p < 12; p++)
+				ASSERT_EQ(images(p, i), (*reference.data(first + i))(p));
+		}//: for
+	}//: for
+
+	// Random batch - the index of the sample can be recovered from its first pixel.
+	importer.getRandomBatch(images, labels);
+	for (size_t i = 0; i < 3; i++) {
+		const size_t index = (size_t)(images(0, i) * 255.0f + 0.5f) / 12;
+		ASSERT_LT(index, 7);
+		ASSERT_EQ(labels[i], index);
+	}//: for
+
+	// Positions out of range.
+	const size_t positions[2] = {1, 7};
+	ASSERT_THROW(importer.materialize(positions, 2, images, labels), std::out_of_range);
+
+	// Batch bigger than the dataset.
+	importer.setBatchSize(8);
+	ASSERT_THROW(importer.getNextBatch(images, labels), std::logic_error);
+}
+
+
+/*!
+ * Tests handling of invalid and empty datasets.
+ */
+TEST(MNISTMappedImporter, InvalidDatasets) {
+	// Number of images differs from the number of labels.
+	writeSyntheticMNIST(4);
+	writeIdx("test-labels.idx", {3}, {0, 1, 2});
+	mic::importers::MNISTMappedImporter<float> importer("mnist_mapped", "test-images.idx", "test-labels.idx", 2);
+	ASSERT_FALSE(importer.importData());
+
+	// Truncated images.
+	writeSyntheticMNIST(4);
+	writeIdx("test-images.idx", {4, 3, 4}, std::vector<uint8_t>(40, 0));
+	ASSERT_FALSE(importer.importData());
+
+	// Empty (but valid) dataset - nothing can be drawn.
+	writeSyntheticMNIST(0);
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 0);
+	mic::types::Matrix<float> images;
+	std::vector<unsigned int> labels;
+	ASSERT_THROW(importer.getRandomBatch(images, labels), std::logic_error);
+	ASSERT_THROW(importer.getNextBatch(images, labels), std::logic_error);
+}
+
+/*!
+ * Tests whether a failed re-import does not leave samples of the previous import (pointing to closed mappings).
+ */
+TEST(MNISTMappedImporter, FailedReimport) {
+	writeSyntheticMNIST(4);
+	mic::importers::MNISTMappedImporter<float> importer("mnist_mapped", "test-images.idx", "test-labels.idx", 2);
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 4);
+
+	// Missing file.
+	importer.setDataFilename("test-images-missing.idx");
+	ASSERT_FALSE(importer.importData());
+	ASSERT_EQ(importer.size(), 0);
+	mic::types::Matrix<float> images;
+	std::vector<unsigned int> labels;
+	ASSERT_THROW(importer.getNextBatch(images, labels), std::logic_error);
+	ASSERT_THROW(importer.getRandomBatch(images, labels), std::logic_error);
+	ASSERT_THROW(importer.getSample(0), std::out_of_range);
+
+	// Number of images differs from the number of labels.
+	importer.setDataFilename("test-images.idx");
+	ASSERT_TRUE(importer.importData());
+	writeIdx("test-labels.idx", {3}, {0, 1, 2});
+	ASSERT_FALSE(importer.importData());
+	ASSERT_EQ(importer.size(), 0);
+}
+
+
+
+/*!
+ * Tests decoding of patch indices and whether single patches, batches of patches and im2col are consistent with each other and with MNISTPatchImporter.
+ */
+TEST(MNISTPatchDataset, Patches) {
+	// MNISTPatchImporter handles only 28x28 images.
+	writeSyntheticMNIST(3, 28, 28);
+	mic::importers::MNISTPatchDataset dataset("mnist_patch_dataset", 4);
+	dataset.setDataFilename("test-images.idx");
+	dataset.setLabelsFilename("test-labels.idx");
+	ASSERT_TRUE(dataset.importData());
+	ASSERT_EQ(dataset.getPatchSize(), 5);
+	ASSERT_EQ(dataset.images(), 3);
+	ASSERT_EQ(dataset.patchesPerImage(), 24 * 24);
+	ASSERT_EQ(dataset.size(), 3 * 24 * 24);
+
+	// Decode.
+	size_t image, y, x;
+	dataset.decode(2 * 576 + 3 * 24 + 7, image, y, x);
+	ASSERT_EQ(image, 2);
+	ASSERT_EQ(y, 3);
+	ASSERT_EQ(x, 7);
+	dataset.decode(dataset.size() - 1, image, y, x);
+	ASSERT_EQ(image, 2);
+	ASSERT_EQ(y, 23);
+	ASSERT_EQ(x, 23);
+
+	// Single patch - compare with pixels of the image.
+	mic::types::MatrixXfPtr patch = dataset.getPatch(576 + 10 * 24 + 17);
+	ASSERT_EQ(patch->rows(), 5);
+	ASSERT_EQ(patch->cols(), 5);
+	for (size_t yp = 0; yp < 5; yp++)
+		for (size_t xp = 0; xp < 5; xp++)
+			ASSERT_FLOAT_EQ((*patch)(yp, xp), (float)((784 + (10 + yp) * 28 + 17 + xp) % 256) / 255.0f);
+	ASSERT_EQ(dataset.label(576 + 10 * 24 + 17), 1);
+	ASSERT_THROW(dataset.getPatch(dataset.size()), std::out_of_range);
+
+	// im2col - column j is the j-th patch of the image.
+	mic::types::MatrixXf columns;
+	dataset.im2col(1, columns);
+	ASSERT_EQ(columns.rows(), 25);
+	ASSERT_EQ(columns.cols(), 576);
+	for (size_t j = 0; j < 576; j++) {
+		patch = dataset.getPatch(576 + j);
+		for (size_t k = 0; k < 25; k++)
+			ASSERT_EQ(columns(k, j), patch->data()[k]);
+	}//: for
+	ASSERT_THROW(dataset.im2col(3, columns), std::out_of_range);
+
+	// Batch of patches.
+	const size_t indices[3] = {0, 577, dataset.size() - 1};
+	mic::types::MatrixXf patches;
+	std::vector<unsigned int> labels;
+	dataset.getPatches(indices, 3, patches, labels);
+	for (size_t i = 0; i < 3; i++) {
+		ASSERT_EQ(labels[i], indices[i] / 576);
+		patch = dataset.getPatch(indices[i]);
+		for (size_t k = 0; k < 25; k++)
+			ASSERT_EQ(patches(k, i), patch->data()[k]);
+	}//: for
+
+	// Patches materialized by MNISTPatchImporter.
+	mic::importers::MNISTPatchImporter importer;
+	importer.setDataFilename("test-images.idx");
+	importer.setLabelsFilename("test-labels.idx");
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), dataset.size());
+	for (size_t i = 0; i < dataset.size(); i++) {
+		ASSERT_EQ(*importer.labels(i), dataset.label(i));
+		ASSERT_EQ(*importer.data(i), *dataset.getPatch(i));
+	}//: for
+}
+
+
+/*!
+ * Tests handling of an empty patch dataset.
+ */
+TEST(MNISTPatchDataset, EmptyDataset) {
+	writeSyntheticMNIST(0, 28, 28);
+	mic::importers::MNISTPatchDataset dataset("mnist_patch_dataset", 4);
+	dataset.setDataFilename("test-images.idx");
+	dataset.setLabelsFilename("test-labels.idx");
+	ASSERT_TRUE(dataset.importData());
+	ASSERT_EQ(dataset.size(), 0);
+
+	mic::types::MatrixXf patches;
+	std::vector<unsigned int> labels;
+	ASSERT_THROW(dataset.getRandomBatch(patches, labels), std::logic_error);
+	ASSERT_THROW(dataset.getNextBatch(patches, labels), std::logic_error);
+}
+
+/*!
+ * Tests whether a failed re-import does not leave patches of the previous import (pointing to closed mappings).
+ */
+TEST(MNISTPatchDataset, FailedReimport) {
+	writeSyntheticMNIST(2, 28, 28);
+	mic::importers::MNISTPatchDataset dataset("mnist_patch_dataset", 4);
+	dataset.setDataFilename("test-images.idx");
+	dataset.setLabelsFilename("test-labels.idx");
+	ASSERT_TRUE(dataset.importData());
+	ASSERT_GT(dataset.size(), 0);
+
+	dataset.setDataFilename("test-images-missing.idx");
+	ASSERT_FALSE(dataset.importData());
+	ASSERT_EQ(dataset.size(), 0);
+	mic::types::MatrixXf patches;
+	std::vector<unsigned int> labels;
+	ASSERT_THROW(dataset.getPatch(0), std::out_of_range);
+	ASSERT_THROW(dataset.getRandomBatch(patches, labels), std::logic_error);
+	ASSERT_THROW(dataset.getNextBatch(patches, labels), std::logic_error);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,346 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MNISTMappedImporter.hpp
+ * \brief Contains declaration (and definition) of a memory-mapped MNIST importer with lazy decoding.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_MNISTMAPPEDIMPORTER_HPP_
+#define SRC_IMPORTERS_MNISTMAPPEDIMPORTER_HPP_
+
+#include <importers/IdxFile.hpp>
+#include <importers/PixelKernels.hpp>
+
+#include <logger/Log.hpp>
+#include <configuration/PropertyTree.hpp>
+
+#include <types/Matrix.hpp>
+
+#include <vector>
+#include <random>
+#include <stdexcept>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Importer mapping the MNIST idx files into memory instead of reading them.
+ * Samples are kept as views of raw (uint8) images - they are converted into normalized (<0,1>) values only when a batch is materialized,
+ * so import is almost instant and the resident memory is 4x smaller than in the case of MNISTMatrixImporter.
+ * Materialized batches have the same layout as the ones packed from MNISTMatrixImporter samples (every image is a column-major column of the batch matrix).
+ * \author tkornuta
+ * \tparam T Type of elements of materialized matrices.
+ */
+template<typename T=float>
+class MNISTMappedImporter : public mic::configuration::PropertyTree {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 * @param data_filename_ File (with path) containing MNIST images.
+	 * @param labels_filename_ File (with path) containing MNIST labels.
+	 * @param batch_size_ Size of the batch.
+	 */
+	MNISTMappedImporter(std::string node_name_ = "mnist_mapped_importer", std::string data_filename_ = "", std::string labels_filename_ = "", size_t batch_size_ = 1) :
+		PropertyTree(node_name_),
+		data_filename("data_filename", data_filename_),
+		labels_filename("labels_filename", labels_filename_),
+		samples_limit("samples_limit", -1),
+		samples(0),
+		image_width(0),
+		image_height(0),
+		next_sample_index(0),
+		batch_size(batch_size_),
+		rng_mt19937_64(rd())
+	{
+		// Register properties - so their values can be overridden (read from the configuration file).
+		this->registerProperty(data_filename);
+		this->registerProperty(labels_filename);
+		this->registerProperty(samples_limit);
+	}
+
+	/*!
+	 * Virtual destructor. Empty.
+	 */
+	virtual ~MNISTMappedImporter() {}
+
+	/*!
+	 * Set name and patch of the file containing MNIST images.
+	 * @param data_filename_ File (with path) containing MNIST images.
+	 */
+	void setDataFilename(std::string data_filename_) {
+		data_filename = data_filename_;
+	}
+
+	/*!
+	 * Set name and patch of the file containing MNIST labels.
+	 * @param labels_filename_ File (with path) containing MNIST labels.
+	 */
+	void setLabelsFilename(std::string labels_filename_){
+		labels_filename = labels_filename_;
+	}
+
+	/*!
+	 * Method responsible for mapping the MNIST files and validating their headers - no data is read.
+	 * @return TRUE if data mapped successfully, FALSE otherwise.
+	 */
+	bool importData() {
+		// Forget the previous import - opening a file closes its old mapping.
+		samples = 0;
+		image_height = 0;
+		image_width = 0;
+		next_sample_index = 0;
+
+		LOG(LSTATUS) << "Mapping file containing MNIST labels: " << labels_filename;
+		if (!labels_file.open(labels_filename, 1))
+			return false;
+
+		LOG(LSTATUS) << "Mapping file containing MNIST images: " << data_filename;
+		if (!data_file.open(data_filename, 3))
+			return false;
+
+		if (labels_file.count() != data_file.count()) {
+			LOG(LERROR) << "Number of labels (" << labels_file.count() << ") differs from the number of images (" << data_file.count() << ")";
+			return false;
+		}//: if
+
+		image_height = data_file.dim(1);
+		image_width = data_file.dim(2);
+		samples = data_file.count();
+		// Check limit.
+		if ((samples_limit > 0) && ((size_t)samples_limit < samples))
+			samples = (size_t)samples_limit;
+		next_sample_index = 0;
+
+		LOG(LINFO) << "Mapped " << samples << " MNIST samples of size " << image_height << "x" << image_width;
+		return true;
+	}
+
+	/*!
+	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
+	 */
+	virtual void initializePropertyDependentVariables() {}
+
+	/// Returns the number of samples.
+	size_t size() const {
+		return samples;
+	}
+
+	/// Returns the number of classes.
+	size_t classes() const {
+		return 10;
+	}
+
+	/// Returns width of the image.
+	size_t imageWidth() const {
+		return image_width;
+	}
+
+	/// Returns height of the image.
+	size_t imageHeight() const {
+		return image_height;
+	}
+
+	/// Returns size of the sample (number of pixels).
+	size_t sampleSize() const {
+		return image_width * image_height;
+	}
+
+	/*!
+	 * Returns raw (row-major) image of a given sample - a view of the mapped file.
+	 * @param index_ Index of the sample.
+	 */
+	const uint8_t* image(size_t index_) const {
+		return data_file.item(index_);
+	}
+
+	/*!
+	 * Returns label of a given sample.
+	 * @param index_ Index of the sample.
+	 */
+	unsigned int label(size_t index_) const {
+		return (unsigned int)*labels_file.item(index_);
+	}
+
+	/*!
+	 * Sets the size of the batch.
+	 * @param batch_size_ Size of the batch.
+	 */
+	void setBatchSize(size_t batch_size_) {
+		batch_size = batch_size_;
+	}
+
+	/// Returns the size of the batch.
+	size_t getBatchSize() const {
+		return batch_size;
+	}
+
+	/*!
+	 * Sets the index of the next sample.
+	 * @param index_ Index.
+	 */
+	void setNextSampleIndex(size_t index_ = 0) {
+		next_sample_index = index_;
+	}
+
+	/*!
+	 * Converts a single sample into a (newly allocated) matrix of size height x width.
+	 * If the index is out of range throws an "std::out_of_range" exception.
+	 * @param index_ Index of the sample.
+	 * @return Shared pointer to the matrix.
+	 */
+	mic::types::MatrixPtr<T> getSample(size_t index_) {
+		if (index_ >= samples)
+			throw std::out_of_range("MNISTMappedImporter: sample index out of range!");
+		mic::types::MatrixPtr<T> image_ptr (new mic::types::Matrix<T>(image_height, image_width));
+		convert(image(index_), image_ptr->data());
+		return image_ptr;
+	}
+
+	/*!
+	 * Materializes selected samples - converts images into a matrix (pixels x number of samples) and copies their labels.
+	 * The matrix and vector are resized only if their sizes do not match, so they can (and should) be reused across iterations.
+	 * If any position is out of range throws an "std::out_of_range" exception.
+	 * @param positions_ Table of positions of samples.
+	 * @param size_ Number of samples.
+	 * @param images_ Output matrix.
+	 * @param labels_ Output vector of labels.
+	 */
+	void materialize(const size_t* positions_, size_t size_, mic::types::Matrix<T>& images_, std::vector<unsigned int>& labels_) {
+		const size_t sample_size = sampleSize();
+		images_.resize(sample_size, size_);
+		labels_.resize(size_);
+		for (size_t i = 0; i < size_; i++) {
+			if (positions_[i] >= samples)
+				throw std::out_of_range("MNISTMappedImporter: sample index out of range!");
+			labels_[i] = label(positions_[i]);
+		}//: for
+
+		T* out_ptr = images_.data();
+#pragma omp parallel for if(mic::types::useParallel(size_ * sample_size))
+		for (size_t i = 0; i < size_; i++)
+			convert(image(positions_[i]), out_ptr + i * sample_size);
+	}
+
+	/*!
+	 * Materializes the next batch of samples. If there are not enough samples left, starts from the beginning.
+	 * If the batch size is greater than the number of samples throws an "std::logic_error" exception.
+	 * @param images_ Output matrix.
+	 * @param labels_ Output vector of labels.
+	 */
+	void getNextBatch(mic::types::Matrix<T>& images_, std::vector<unsigned int>& labels_) {
+		if (batch_size > samples)
+			throw std::logic_error("MNISTMappedImporter: batch size exceeds the number of samples!");
+		// Check index.
+		if ((next_sample_index + batch_size) > samples)
+			next_sample_index = 0;
+		positions.resize(batch_size);
+		for (size_t i = 0; i < batch_size; i++)
+			positions[i] = next_sample_index + i;
+		next_sample_index += batch_size;
+		materialize(positions.data(), batch_size, images_, labels_);
+	}
+
+	/*!
+	 * Materializes a batch of random samples (the same sample can be selected many times - n-tuples).
+	 * If there are no samples throws an "std::logic_error" exception.
+	 * @param images_ Output matrix.
+	 * @param labels_ Output vector of labels.
+	 */
+	void getRandomBatch(mic::types::Matrix<T>& images_, std::vector<unsigned int>& labels_) {
+		if (samples == 0)
+			throw std::logic_error("MNISTMappedImporter: cannot draw samples from an empty dataset!");
+		std::uniform_int_distribution<size_t> index_dist(0, samples - 1);
+		positions.resize(batch_size);
+		for (size_t i = 0; i < batch_size; i++)
+			positions[i] = index_dist(rng_mt19937_64);
+		materialize(positions.data(), batch_size, images_, labels_);
+	}
+
+	/*!
+	 * Checks if the returned batch was the last possible one.
+	 * @return True if the batch was the last one.
+	 */
+	bool isLastBatch() const {
+		return ((next_sample_index + batch_size) >= samples);
+	}
+
+protected:
+	/*!
+	 * Converts a raw (row-major) image into normalized values stored in column-major order - as in Matrix(row, col).
+	 * @param image_ Raw image.
+	 * @param out_ Output table.
+	 */
+	void convert(const uint8_t* image_, T* out_) const {
+		mic::importers::u8ToRealTransposed(image_, image_height, image_width, out_);
+	}
+
+	/*!
+	 * Property: directory/Name of file containing images (binary datafile).
+	 */
+	mic::configuration::Property<std::string> data_filename;
+
+	/*!
+	 * Property: directory/Name of file containing labels.
+	 */
+	mic::configuration::Property<std::string> labels_filename;
+
+	/*!
+	 * Property: maximum number of samples (limitation, from 1 to 60000). If <=0 then there is no limitation.
+	 */
+	mic::configuration::Property<int> samples_limit;
+
+	/// Mapped file containing images.
+	IdxFile data_file;
+
+	/// Mapped file containing labels.
+	IdxFile labels_file;
+
+	/// Number of samples.
+	size_t samples;
+
+	/// Width of MNIST image.
+	size_t image_width;
+
+	/// Height of MNIST image.
+	size_t image_height;
+
+	/// Index of the next sample.
+	size_t next_sample_index;
+
+	/// Size of the batch.
+	size_t batch_size;
+
+	/// Buffer with positions of samples of the batch - reused across batches.
+	std::vector<size_t> positions;
+
+	/*!
+	 * Random device used for generation of random numbers.
+	 */
+	std::random_device rd;
+
+	/*!
+	 *  Mersenne Twister pseudo-random generator of 64-bit numbers.
+	 */
+	std::mt19937_64 rng_mt19937_64;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_MNISTMAPPEDIMPORTER_HPP_ */
@@ -25,8 +25,12 @@
 #define SRC_importers_MNISTMATRIXIMPORTER_HPP_
 
 #include <importers/Importer.hpp>
+#include <importers/IdxFile.hpp>
+#include <importers/PixelKernels.hpp>
 #include <types/MNISTTypes.hpp>
-#include <fstream>
+#include <types/SampleArena.hpp>
+
+#include <algorithm>
 
 namespace mic {
 namespace importers {
@@ -81,81 +85,32 @@ public:
 	 * @return TRUE if data loaded successfully, FALSE otherwise.
 	 */
     bool importData(){
-
-        char buffer[28*28];
-        int label_offset_bytes = 8;
-        int data_offset_bytes = 16;
-        size_t sample = 0;
-
-        // Try to open file with labels.
-        LOG(LSTATUS) << "Opening file containing MNIST labels: " << labels_filename;
-        std::ifstream labels_file(labels_filename, std::ios::in | std::ios::binary);
-        if (!labels_file.is_open()) {
-            LOG(LFATAL) << "Oops! Couldn't find file: " << labels_filename;
-            return false;
-        }//: else
-
-        // Read file containing images (binary format).
-        LOG(LSTATUS) << "Opening file containing MNIST images: " << data_filename;
-        std::ifstream data_file(data_filename, std::ios::in | std::ios::binary);
-        if (!data_file.is_open()) {
-            LOG(LFATAL) << "Oops! Couldn't find file: " << data_filename;
+        mic::importers::IdxFile labels_file, data_file;
+        size_t samples;
+        if (!openFiles(labels_file, data_file, samples))
             return false;
-        }
-
-        // Label and image files ok - import digits.
-        LOG(LSTATUS) << "Importing MNIST digits. This might take a while...";
 
-        // Skip label header.
-        labels_file.seekg (label_offset_bytes, std::ios::beg);
-        // Skip data header.
-        data_file.seekg (data_offset_bytes , std::ios::beg);
+        sample_data.reserve(samples);
+        sample_labels.reserve(samples);
+        sample_indices.reserve(samples);
 
         // Import loop.
-        while(true) {
-            // Try to read the label.
-            labels_file.read(buffer, 1);
-            // If reached the EOF.
-            if (labels_file.eof())
-                break;
-            // Else: get the label.
-            unsigned int temp_label = (unsigned int)buffer[0];
-
-            // Try to read the image into buffer.
-            data_file.read(buffer, image_width*image_height);
-            // If reached the EOF.
-            if (data_file.eof())
-                break;
-            // Else: get image.
+        for (size_t sample = 0; sample < samples; sample++) {
+            // Get the label.
+            unsigned int temp_label = (unsigned int)*labels_file.item(sample);
 
             // Create new matrix of MNIST image size.
             mic::types::MatrixPtr<T> image_ptr (new mic::types::Matrix<T>(image_height, image_width));
 
-            // Parse and set image data.
-            for (size_t i = 0; i < (size_t)(image_width*image_height); i++) {
-                unsigned row = i / image_width;
-                unsigned col = i % image_height;
-                (*image_ptr)(row, col) = (T)((uint8_t)buffer[i])/(T)255.0f;
-            }//: for
-
-            // Got the image and label.
-            LOG(LDEBUG) << "Loading MNIST sample: " << sample;
+            // Parse and set image data - the image is stored row by row.
+            mic::importers::u8ToRealTransposed(data_file.item(sample), image_height, image_width, image_ptr->data());
 
             sample_data.push_back(image_ptr);
             sample_labels.push_back(std::make_shared <unsigned int> (temp_label) );
-
-            sample++;
-            // Check limit.
-            if ((samples_limit > 0) && (sample >= (size_t)samples_limit))
-                break;
-        }//: while !eof
+        }//: for
 
         LOG(LINFO) << "Imported " << sample_labels.size() << " patches";
 
-        // Close files
-        labels_file.close();
-        data_file.close();
-
         // Fill the indices table(!)
         for (size_t i=0; i < sample_data.size(); i++ )
             sample_indices.push_back(i);
@@ -168,12 +123,69 @@ public:
         return true;
     }
 
+	/*!
+	 * Imports the MNIST dataset into an arena - images are decoded straight into the slab, so there are no per-sample allocations.
+	 * The arena is reset to the shape of images (height x width, column-major, as in importData()). Samples of the importer (batch) are not modified.
+	 * @param arena_ Destination arena.
+	 * @return TRUE if data loaded successfully, FALSE otherwise.
+	 */
+    bool importData(mic::types::SampleArena<T, unsigned int>& arena_){
+        mic::importers::IdxFile labels_file, data_file;
+        size_t samples;
+        if (!openFiles(labels_file, data_file, samples))
+            return false;
+
+        arena_ = mic::types::SampleArena<T, unsigned int>({(size_t)image_height, (size_t)image_width});
+        arena_.reserve(samples);
+
+        // Import loop.
+        for (size_t sample = 0; sample < samples; sample++) {
+            T* data = arena_.add((unsigned int)*labels_file.item(sample));
+            mic::importers::u8ToRealTransposed(data_file.item(sample), image_height, image_width, data);
+        }//: for
+
+        LOG(LINFO) << "Imported " << arena_.size() << " samples into arena";
+        return true;
+    }
+
 	/*!
 	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
 	 */
     virtual void initializePropertyDependentVariables() {}
 
 private:
+	/*!
+	 * Maps files with labels and images, validates their headers and sets the image properties.
+	 * @param labels_file_ File with labels.
+	 * @param data_file_ File with images.
+	 * @param samples_ Returned number of samples to be imported (taking into account the limit).
+	 * @return TRUE if files were opened successfully, FALSE otherwise.
+	 */
+    bool openFiles(mic::importers::IdxFile& labels_file_, mic::importers::IdxFile& data_file_, size_t& samples_) {
+        // Map the file with labels and validate its header.
+        LOG(LSTATUS) << "Opening file containing MNIST labels: " << labels_filename;
+        if (!labels_file_.open(labels_filename, 1))
+            return false;
+
+        // Map the file containing images (binary format) and validate its header.
+        LOG(LSTATUS) << "Opening file containing MNIST images: " << data_filename;
+        if (!data_file_.open(data_filename, 3))
+            return false;
+
+        // Get image properties from the header.
+        image_height = data_file_.dim(1);
+        image_width = data_file_.dim(2);
+
+        // Label and image files ok - import digits.
+        LOG(LSTATUS) << "Importing MNIST digits. This might take a while...";
+
+        samples_ = std::min(labels_file_.count(), data_file_.count());
+        // Check limit.
+        if ((samples_limit > 0) && ((size_t)samples_limit < samples_))
+            samples_ = (size_t)samples_limit;
+        return true;
+    }
+
 	/*!
 	 * Width of MNIST image.
 	 */
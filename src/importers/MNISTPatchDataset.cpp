@@ -0,0 +1,188 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MNISTPatchDataset.cpp
+ * \brief Contains definition of methods of a virtual dataset of MNIST patches.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#include <importers/MNISTPatchDataset.hpp>
+#include <importers/PixelKernels.hpp>
+
+#include <logger/Log.hpp>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring> // memcpy
+
+namespace mic {
+namespace importers {
+
+MNISTPatchDataset::MNISTPatchDataset(std::string node_name_, size_t batch_size_) : PropertyTree(node_name_),
+	image_width(0),
+	image_height(0),
+	number_of_images(0),
+	patches_per_row(0),
+	patches_per_col(0),
+	next_index(0),
+	batch_size(batch_size_),
+	data_filename("data_filename","data_filename"),
+	labels_filename("labels_filename","labels_filename"),
+	patch_size("patch_size",5),
+	samples_limit("samples_limit",-1),
+	rng_mt19937_64(rd())
+{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(data_filename);
+	registerProperty(labels_filename);
+	registerProperty(patch_size);
+	registerProperty(samples_limit);
+}
+
+bool MNISTPatchDataset::importData() {
+	// Forget the previous import - opening a file closes its old mapping.
+	image_width = 0;
+	image_height = 0;
+	number_of_images = 0;
+	patches_per_row = 0;
+	patches_per_col = 0;
+	next_index = 0;
+
+	LOG(LSTATUS) << "Mapping file containing MNIST labels: " << labels_filename;
+	if (!labels_file.open(labels_filename, 1))
+		return false;
+
+	LOG(LSTATUS) << "Mapping file containing MNIST images: " << data_filename;
+	if (!data_file.open(data_filename, 3))
+		return false;
+
+	image_height = data_file.dim(1);
+	image_width = data_file.dim(2);
+
+	// Limit patch size.
+	size_t max_size = std::min(image_width, image_height);
+	if (patch_size < 1)
+		patch_size = 1;
+	else if (patch_size > max_size)
+		patch_size = max_size;
+	patches_per_col = image_height - patch_size + 1;
+	patches_per_row = image_width - patch_size + 1;
+
+	number_of_images = std::min(labels_file.count(), data_file.count());
+	// Check limit.
+	if ((samples_limit > 0) && ((size_t)samples_limit < number_of_images))
+		number_of_images = (size_t)samples_limit;
+	next_index = 0;
+
+	LOG(LINFO) << "Mapped " << number_of_images << " MNIST images (" << size() << " patches of size " << patch_size << " by " << patch_size << ")";
+	return true;
+}
+
+void MNISTPatchDataset::decode(size_t index_, size_t& image_, size_t& y_, size_t& x_) const {
+	const size_t per_image = patchesPerImage();
+	image_ = index_ / per_image;
+	size_t offset = index_ % per_image;
+	y_ = offset / patches_per_row;
+	x_ = offset % patches_per_row;
+}
+
+void MNISTPatchDataset::extractPatch(size_t image_, size_t y_, size_t x_, float* out_) const {
+	const uint8_t* image = data_file.item(image_);
+	const size_t ps = patch_size;
+	// Convert rows of the image into columns of the column-major output.
+	for (size_t yp = 0; yp < ps; yp++) {
+		const uint8_t* row = image + (y_ + yp) * image_width + x_;
+		for (size_t xp = 0; xp < ps; xp++)
+			out_[xp * ps + yp] = (float)row[xp] * mic::importers::PIXEL_SCALE;
+	}//: for
+}
+
+mic::types::MatrixXfPtr MNISTPatchDataset::getPatch(size_t index_) const {
+	if (index_ >= size())
+		throw std::out_of_range("MNISTPatchDataset: patch index out of range!");
+	size_t image, y, x;
+	decode(index_, image, y, x);
+	mic::types::MatrixXfPtr patch (new mic::types::MatrixXf(patch_size, patch_size));
+	extractPatch(image, y, x, patch->data());
+	return patch;
+}
+
+void MNISTPatchDataset::getPatches(const size_t* indices_, size_t size_, mic::types::MatrixXf& patches_, std::vector<unsigned int>& labels_) const {
+	const size_t patch_elements = patch_size * patch_size;
+	patches_.resize(patch_elements, size_);
+	labels_.resize(size_);
+	for (size_t i = 0; i < size_; i++) {
+		if (indices_[i] >= size())
+			throw std::out_of_range("MNISTPatchDataset: patch index out of range!");
+		labels_[i] = label(indices_[i]);
+	}//: for
+
+	float* out_ptr = patches_.data();
+#pragma omp parallel for if(mic::types::useParallel(size_ * patch_elements))
+	for (size_t i = 0; i < size_; i++) {
+		size_t image, y, x;
+		decode(indices_[i], image, y, x);
+		extractPatch(image, y, x, out_ptr + i * patch_elements);
+	}//: for
+}
+
+void MNISTPatchDataset::im2col(size_t image_, mic::types::MatrixXf& patches_) const {
+	if (image_ >= number_of_images)
+		throw std::out_of_range("MNISTPatchDataset: image index out of range!");
+	const size_t patch_elements = patch_size * patch_size;
+	patches_.resize(patch_elements, patchesPerImage());
+
+	// Convert the image once, then copy the patches.
+	mic::types::MatrixXf image(image_height, image_width);
+	mic::importers::u8ToRealTransposed(data_file.item(image_), image_height, image_width, image.data());
+
+	float* out_ptr = patches_.data();
+	const size_t ps = patch_size;
+	for (size_t y = 0; y < patches_per_col; y++)
+		for (size_t x = 0; x < patches_per_row; x++) {
+			float* patch = out_ptr + (y * patches_per_row + x) * patch_elements;
+			// Columns of the patch are contiguous fragments of the columns of the image.
+			for (size_t xp = 0; xp < ps; xp++)
+				memcpy(patch + xp * ps, image.data() + (x + xp) * image_height + y, ps * sizeof(float));
+		}//: for
+}
+
+void MNISTPatchDataset::getNextBatch(mic::types::MatrixXf& patches_, std::vector<unsigned int>& labels_) {
+	if (batch_size > size())
+		throw std::logic_error("MNISTPatchDataset: batch size exceeds the number of patches!");
+	// Check index.
+	if ((next_index + batch_size) > size())
+		next_index = 0;
+	batch_indices.resize(batch_size);
+	for (size_t i = 0; i < batch_size; i++)
+		batch_indices[i] = next_index + i;
+	next_index += batch_size;
+	getPatches(batch_indices.data(), batch_size, patches_, labels_);
+}
+
+void MNISTPatchDataset::getRandomBatch(mic::types::MatrixXf& patches_, std::vector<unsigned int>& labels_) {
+	if (size() == 0)
+		throw std::logic_error("MNISTPatchDataset: cannot draw patches from an empty dataset!");
+	std::uniform_int_distribution<size_t> index_dist(0, size() - 1);
+	batch_indices.resize(batch_size);
+	for (size_t i = 0; i < batch_size; i++)
+		batch_indices[i] = index_dist(rng_mt19937_64);
+	getPatches(batch_indices.data(), batch_size, patches_, labels_);
+}
+
+} /* namespace importers */
+} /* namespace mic */
@@ -0,0 +1,262 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MNISTPatchDataset.hpp
+ * \brief Contains declaration of a virtual dataset of MNIST patches, extracted on demand from memory-mapped images.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_MNISTPATCHDATASET_HPP_
+#define SRC_IMPORTERS_MNISTPATCHDATASET_HPP_
+
+#include <importers/IdxFile.hpp>
+
+#include <configuration/PropertyTree.hpp>
+#include <types/MatrixTypes.hpp>
+
+#include <vector>
+#include <random>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Virtual dataset of all (overlapping) patches of MNIST images - an alternative to MNISTPatchImporter that does not materialize the patches.
+ * Only the (memory-mapped) source images are kept, a patch with index i is computed on demand from (image, y, x) decoded from i.
+ * Patches are numbered in the same order as in MNISTPatchImporter (image by image, row by row), they also have the same layout.
+ * \author tkornuta
+ */
+class MNISTPatchDataset : public mic::configuration::PropertyTree {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 * @param batch_size_ Size of the batch.
+	 */
+	MNISTPatchDataset(std::string node_name_ = "mnist_patch_dataset", size_t batch_size_ = 1);
+
+	/*!
+	 * Virtual destructor. Empty.
+	 */
+	virtual ~MNISTPatchDataset() { };
+
+	/*!
+	 * Maps the MNIST files and validates their headers - no patches are created.
+	 * @return TRUE if data mapped successfully, FALSE otherwise.
+	 */
+	bool importData();
+
+	/*!
+	 * Sets data filename (with path).
+	 * @param data_filename_ Path and filename
+	 */
+	void setDataFilename(std::string data_filename_) {
+		data_filename = data_filename_;
+	}
+
+	/*!
+	 * Sets labels filename (with path).
+	 * @param labels_filename_ Path and filename
+	 */
+	void setLabelsFilename(std::string labels_filename_) {
+		labels_filename = labels_filename_;
+	}
+
+	/*!
+	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
+	 */
+	virtual void initializePropertyDependentVariables() { };
+
+	/// Returns the patch size.
+	size_t getPatchSize() const { return patch_size; }
+
+	/// Returns the number of images.
+	size_t images() const { return number_of_images; }
+
+	/// Returns the number of patches in a single image.
+	size_t patchesPerImage() const { return patches_per_row * patches_per_col; }
+
+	/// Returns the number of all patches.
+	size_t size() const { return number_of_images * patchesPerImage(); }
+
+	/// Returns the number of classes.
+	size_t classes() const { return 10; }
+
+	/*!
+	 * Decodes the patch index into image index and position of the patch.
+	 * @param index_ Index of the patch.
+	 * @param image_ Index of the image.
+	 * @param y_ Row of the upper-left corner of the patch.
+	 * @param x_ Column of the upper-left corner of the patch.
+	 */
+	void decode(size_t index_, size_t& image_, size_t& y_, size_t& x_) const;
+
+	/*!
+	 * Returns label of a given patch (i.e. label of its image).
+	 * @param index_ Index of the patch.
+	 */
+	unsigned int label(size_t index_) const {
+		return (unsigned int)*labels_file.item(index_ / patchesPerImage());
+	}
+
+	/*!
+	 * Extracts the patch into a table (column-major, i.e. with the layout of the patch_size x patch_size matrix).
+	 * @param image_ Index of the image.
+	 * @param y_ Row of the upper-left corner of the patch.
+	 * @param x_ Column of the upper-left corner of the patch.
+	 * @param out_ Output table.
+	 */
+	void extractPatch(size_t image_, size_t y_, size_t x_, float* out_) const;
+
+	/*!
+	 * Returns a (newly allocated) patch.
+	 * If the index is out of range throws an "std::out_of_range" exception.
+	 * @param index_ Index of the patch.
+	 * @return Shared pointer to the patch_size x patch_size matrix.
+	 */
+	mic::types::MatrixXfPtr getPatch(size_t index_) const;
+
+	/*!
+	 * Extracts selected patches into a matrix (patch_size^2 x number of patches), one patch per column (im2col).
+	 * The matrix and vector are resized only if their sizes do not match, so they can (and should) be reused across iterations.
+	 * If any index is out of range throws an "std::out_of_range" exception.
+	 * @param indices_ Table of indices of patches.
+	 * @param size_ Number of patches.
+	 * @param patches_ Output matrix.
+	 * @param labels_ Output vector of labels.
+	 */
+	void getPatches(const size_t* indices_, size_t size_, mic::types::MatrixXf& patches_, std::vector<unsigned int>& labels_) const;
+
+	/*!
+	 * Extracts all patches of a given image into a matrix (patch_size^2 x patches per image), one patch per column (im2col).
+	 * If the index is out of range throws an "std::out_of_range" exception.
+	 * @param image_ Index of the image.
+	 * @param patches_ Output matrix.
+	 */
+	void im2col(size_t image_, mic::types::MatrixXf& patches_) const;
+
+	/*!
+	 * Sets the size of the batch.
+	 * @param batch_size_ Size of the batch.
+	 */
+	void setBatchSize(size_t batch_size_) {
+		batch_size = batch_size_;
+	}
+
+	/// Returns the size of the batch.
+	size_t getBatchSize() const {
+		return batch_size;
+	}
+
+	/*!
+	 * Extracts the next batch of patches. If there are not enough patches left, starts from the beginning.
+	 * If the batch size is greater than the number of patches throws an "std::logic_error" exception.
+	 * @param patches_ Output matrix.
+	 * @param labels_ Output vector of labels.
+	 */
+	void getNextBatch(mic::types::MatrixXf& patches_, std::vector<unsigned int>& labels_);
+
+	/*!
+	 * Extracts a batch of random patches (the same patch can be selected many times - n-tuples).
+	 * If there are no patches throws an "std::logic_error" exception.
+	 * @param patches_ Output matrix.
+	 * @param labels_ Output vector of labels.
+	 */
+	void getRandomBatch(mic::types::MatrixXf& patches_, std::vector<unsigned int>& labels_);
+
+	/*!
+	 * Checks if the returned batch was the last possible one.
+	 * @return True if the batch was the last one.
+	 */
+	bool isLastBatch() const {
+		return ((next_index + batch_size) >= size());
+	}
+
+	/*!
+	 * Sets the index of the next patch.
+	 * @param index_ Index.
+	 */
+	void setNextIndex(size_t index_ = 0) {
+		next_index = index_;
+	}
+
+private:
+	/// Width of MNIST image.
+	size_t image_width;
+
+	/// Height of MNIST image.
+	size_t image_height;
+
+	/// Number of images.
+	size_t number_of_images;
+
+	/// Number of patches in a row of the image.
+	size_t patches_per_row;
+
+	/// Number of patches in a column of the image.
+	size_t patches_per_col;
+
+	/// Mapped file containing images.
+	IdxFile data_file;
+
+	/// Mapped file containing labels.
+	IdxFile labels_file;
+
+	/// Index of the next patch.
+	size_t next_index;
+
+	/// Size of the batch.
+	size_t batch_size;
+
+	/// Buffer with indices of patches of the batch - reused across batches.
+	std::vector<size_t> batch_indices;
+
+	/*!
+	 * Property: directory/Name of file containing images (binary datafile).
+	 */
+	mic::configuration::Property<std::string> data_filename;
+
+	/*!
+	 * Property: directory/Name of file containing labels.
+	 */
+	mic::configuration::Property<std::string> labels_filename;
+
+	/*!
+	 * Property: patch size (width & height).
+	 */
+	mic::configuration::Property<size_t> patch_size;
+
+	/*!
+	 * Property: maximum number of images (limitation, from 1 to 60000). If <=0 then there is no limitation.
+	 */
+	mic::configuration::Property<int> samples_limit;
+
+	/*!
+	 * Random device used for generation of random numbers.
+	 */
+	std::random_device rd;
+
+	/*!
+	 *  Mersenne Twister pseudo-random generator of 64-bit numbers.
+	 */
+	std::mt19937_64 rng_mt19937_64;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_MNISTPATCHDATASET_HPP_ */
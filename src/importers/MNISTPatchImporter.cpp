@@ -21,6 +21,7 @@
  */
 
 #include <importers/MNISTPatchImporter.hpp>
+#include <importers/PixelKernels.hpp>
 #include <logger/Log.hpp>
 
 
@@ -102,15 +103,12 @@ bool MNISTPatchImporter::importData(){
 		// Create new matrix of MNIST image size.
 		mic::types::MatrixXf image(image_height, image_width);
 
-		// Parse and set image data.
-		for (size_t i = 0; i < (size_t)(image_width*image_height); i++) {
-			unsigned row = i / image_width;
-			unsigned col = i % image_height;
-			image(row, col) = (float)((uint8_t)buffer[i])/255.0f;
-		}//: for
+		// Parse and set image data - the image is stored row by row.
+		mic::importers::u8ToRealTransposed((const uint8_t*)buffer, image_height, image_width, image.data());
 
-		// Got the image and label - now add the patches...
+		// Got the image and label - now add the patches (sharing the label)...
 		LOG(LDEBUG) << "Loading MNIST sample: " << sample;
+		std::shared_ptr<unsigned int> label_ptr = std::make_shared <unsigned int> (temp_label);
 
 		// Iterate through the image.
 		for (size_t yi=0; (yi+patch_size) <= image_height; yi++)
@@ -126,7 +124,7 @@ bool MNISTPatchImporter::importData(){
 				}//: for patch
 
 				sample_data.push_back(patch);
-				sample_labels.push_back(std::make_shared <unsigned int> (temp_label) );
+				sample_labels.push_back(label_ptr);
 			}//: for image
 
 		sample++;
@@ -0,0 +1,90 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MappedFile.cpp
+ * \brief Contains definition of methods of a read-only, memory-mapped file.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#include <importers/MappedFile.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mic {
+namespace importers {
+
+MappedFile::MappedFile() : data_ptr(nullptr), file_size(0), is_open(false)
+{
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(const std::string& filename_) {
+	close();
+
+	int fd = ::open(filename_.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size < 0)) {
+		::close(fd);
+		return false;
+	}//: if
+
+	// Empty file - there is nothing to map (mmap rejects zero length), yet it is a valid (empty) content.
+	if (st.st_size == 0) {
+		::close(fd);
+		is_open = true;
+		file_name = filename_;
+		return true;
+	}//: if
+
+	void* ptr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after closing the descriptor.
+	::close(fd);
+	if (ptr == MAP_FAILED)
+		return false;
+
+	data_ptr = (const uint8_t*)ptr;
+	file_size = (size_t)st.st_size;
+	is_open = true;
+	file_name = filename_;
+	return true;
+}
+
+void MappedFile::close() {
+	if (data_ptr != nullptr)
+		munmap((void*)data_ptr, file_size);
+	data_ptr = nullptr;
+	file_size = 0;
+	is_open = false;
+	file_name.clear();
+}
+
+void MappedFile::advise(bool sequential_) {
+	if (data_ptr != nullptr)
+		madvise((void*)data_ptr, file_size, sequential_ ? MADV_SEQUENTIAL : MADV_RANDOM);
+}
+
+} /* namespace importers */
+} /* namespace mic */
@@ -0,0 +1,117 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MappedFile.hpp
+ * \brief Contains declaration of a read-only, memory-mapped file.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_MAPPEDFILE_HPP_
+#define SRC_IMPORTERS_MAPPEDFILE_HPP_
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Read-only file mapped into memory (POSIX mmap). Pages are loaded lazily by the OS at first access and are shared between processes mapping the same file.
+ * \author tkornuta
+ */
+class MappedFile {
+public:
+	/*!
+	 * Constructor. Does not map anything.
+	 */
+	MappedFile();
+
+	/*!
+	 * Destructor. Unmaps the file.
+	 */
+	~MappedFile();
+
+	// The mapping cannot be copied.
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/*!
+	 * Maps the whole file into memory (unmaps the previously mapped one).
+	 * An empty file is opened successfully, but nothing is mapped - data() returns nullptr and size() returns 0.
+	 * @param filename_ Name of the file (with path).
+	 * @return TRUE if the file was mapped successfully, FALSE otherwise.
+	 */
+	bool open(const std::string& filename_);
+
+	/*!
+	 * Unmaps the file.
+	 */
+	void close();
+
+	/*!
+	 * Hints the OS about the expected access pattern.
+	 * @param sequential_ TRUE if the file will be read sequentially (aggressive read-ahead), FALSE if randomly (no read-ahead).
+	 */
+	void advise(bool sequential_);
+
+	/*!
+	 * Returns TRUE if a file is opened (mapped or empty).
+	 */
+	bool isOpen() const {
+		return is_open;
+	}
+
+	/*!
+	 * Returns pointer to the mapped content.
+	 */
+	const uint8_t* data() const {
+		return data_ptr;
+	}
+
+	/*!
+	 * Returns the size of the file (in bytes).
+	 */
+	size_t size() const {
+		return file_size;
+	}
+
+	/*!
+	 * Returns the name of the mapped file.
+	 */
+	const std::string& filename() const {
+		return file_name;
+	}
+
+private:
+	/// Pointer to the mapped content.
+	const uint8_t* data_ptr;
+
+	/// Size of the file.
+	size_t file_size;
+
+	/// Flag indicating whether a file is opened.
+	bool is_open;
+
+	/// Name of the file.
+	std::string file_name;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_MAPPEDFILE_HPP_ */
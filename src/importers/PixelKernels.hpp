@@ -0,0 +1,387 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file PixelKernels.hpp
+ * \brief Contains (vectorized) kernels converting raw 8-bit pixels into real values, shared by the image importers.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_PIXELKERNELS_HPP_
+#define SRC_IMPORTERS_PIXELKERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // memcpy
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Default scale of pixel values - maps <0, 255> into <0, 1>.
+ * \author tkornuta
+ */
+const float PIXEL_SCALE = 1.0f / 255.0f;
+
+/*!
+ * Converts a block of 8-bit values into real values: dst[i] = src[i] * scale.
+ * @tparam T Type of the output values.
+ * @param src_ Source bytes.
+ * @param dst_ Destination table.
+ * @param size_ Number of elements.
+ * @param scale_ Scale.
+ */
+template<typename T>
+inline void u8ToReal(const uint8_t* src_, T* dst_, size_t size_, T scale_ = (T)PIXEL_SCALE) {
+	for (size_t i = 0; i < size_; i++)
+		dst_[i] = (T)src_[i] * scale_;
+}
+
+/*!
+ * Converts a block of 8-bit values into floats: dst[i] = src[i] * scale. Uses AVX2 or SSE2 (if available), with a scalar tail.
+ * @param src_ Source bytes.
+ * @param dst_ Destination table.
+ * @param size_ Number of elements.
+ * @param scale_ Scale.
+ */
+template<>
+inline void u8ToReal<float>(const uint8_t* src_, float* dst_, size_t size_, float scale_) {
+	size_t i = 0;
+#if defined(__AVX2__)
+	const __m256 scale = _mm256_set1_ps(scale_);
+	for (; i + 16 <= size_; i += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i*)(src_ + i));
+		__m256i lo = _mm256_cvtepu8_epi32(bytes);
+		__m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8));
+		_mm256_storeu_ps(dst_ + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+		_mm256_storeu_ps(dst_ + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+	}//: for
+#elif defined(__SSE2__)
+	const __m128 scale = _mm_set1_ps(scale_);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= size_; i += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i*)(src_ + i));
+		__m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+		__m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+		_mm_storeu_ps(dst_ + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero)), scale));
+		_mm_storeu_ps(dst_ + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero)), scale));
+		_mm_storeu_ps(dst_ + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero)), scale));
+		_mm_storeu_ps(dst_ + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero)), scale));
+	}//: for
+#endif
+	// Scalar tail.
+	for (; i < size_; i++)
+		dst_[i] = (float)src_[i] * scale_;
+}
+
+/*!
+ * Size of the (square) block of pixels processed at once by the transposing and channel reordering kernels.
+ * Source rows and destination columns of a block stay in L1 cache.
+ */
+const size_t PIXEL_BLOCK_SIZE = 16;
+
+/*!
+ * Converts a row-major image of 8-bit values into a column-major one of real values (i.e. the memory layout of Matrix(row, col)).
+ * The image is processed in blocks of PIXEL_BLOCK_SIZE x PIXEL_BLOCK_SIZE pixels, so that both reads and writes stay in cache.
+ * @tparam T Type of the output values.
+ * @param src_ Source (row-major) image.
+ * @param rows_ Number of rows (height).
+ * @param cols_ Number of columns (width).
+ * @param dst_ Destination (column-major) table.
+ * @param scale_ Scale.
+ */
+template<typename T>
+inline void u8ToRealTransposed(const uint8_t* src_, size_t rows_, size_t cols_, T* dst_, T scale_ = (T)PIXEL_SCALE) {
+	for (size_t row0 = 0; row0 < rows_; row0 += PIXEL_BLOCK_SIZE) {
+		const size_t row1 = std::min(row0 + PIXEL_BLOCK_SIZE, rows_);
+		for (size_t col0 = 0; col0 < cols_; col0 += PIXEL_BLOCK_SIZE) {
+			const size_t col1 = std::min(col0 + PIXEL_BLOCK_SIZE, cols_);
+			for (size_t col = col0; col < col1; col++) {
+				T* dst_col = dst_ + col * rows_;
+				for (size_t row = row0; row < row1; row++)
+					dst_col[row] = (T)src_[row * cols_ + col] * scale_;
+			}//: for col
+		}//: for col0
+	}//: for row0
+}
+
+/*!
+ * Converts a row-major image of 8-bit values into a column-major one of floats.
+ * With SSE2 blocks of 4x4 pixels are converted and transposed in registers, so every store writes 4 consecutive elements of a column.
+ * Remaining rows and columns are converted by the scalar loops.
+ * @param src_ Source (row-major) image.
+ * @param rows_ Number of rows (height).
+ * @param cols_ Number of columns (width).
+ * @param dst_ Destination (column-major) table.
+ * @param scale_ Scale.
+ */
+template<>
+inline void u8ToRealTransposed<float>(const uint8_t* src_, size_t rows_, size_t cols_, float* dst_, float scale_) {
+	size_t row = 0;
+#if defined(__SSE2__)
+	const __m128 scale = _mm_set1_ps(scale_);
+	const __m128i zero = _mm_setzero_si128();
+	for (; row + 4 <= rows_; row += 4) {
+		size_t col = 0;
+		for (; col + 4 <= cols_; col += 4) {
+			int32_t bytes[4];
+			for (size_t k = 0; k < 4; k++)
+				memcpy(&bytes[k], src_ + (row + k) * cols_ + col, 4);
+			__m128 v0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes[0]), zero), zero)), scale);
+			__m128 v1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes[1]), zero), zero)), scale);
+			__m128 v2 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes[2]), zero), zero)), scale);
+			__m128 v3 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes[3]), zero), zero)), scale);
+			// Rows become columns.
+			_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+			_mm_storeu_ps(dst_ + col * rows_ + row, v0);
+			_mm_storeu_ps(dst_ + (col + 1) * rows_ + row, v1);
+			_mm_storeu_ps(dst_ + (col + 2) * rows_ + row, v2);
+			_mm_storeu_ps(dst_ + (col + 3) * rows_ + row, v3);
+		}//: for
+		// Scalar tail - remaining columns.
+		for (; col < cols_; col++)
+			for (size_t k = 0; k < 4; k++)
+				dst_[col * rows_ + row + k] = (float)src_[(row + k) * cols_ + col] * scale_;
+	}//: for
+#endif
+	// Scalar tail - remaining rows.
+	for (; row < rows_; row++)
+		for (size_t col = 0; col < cols_; col++)
+			dst_[col * rows_ + row] = (float)src_[row * cols_ + col] * scale_;
+}
+
+/*!
+ * Converts a range of interleaved 8-bit pixels into planar real values - the scalar part of interleavedToPlanar().
+ * Pixels are processed in blocks, so every block of the source is read from memory once and then from cache for all the planes.
+ * @tparam T Type of the output values.
+ * @param src_ Source (interleaved) pixels.
+ * @param begin_ First converted pixel.
+ * @param end_ Pixel following the last converted one.
+ * @param src_channels_ Number of channels in the source (stride between consecutive pixels).
+ * @param offsets_ Table of offsets of source channels for consecutive destination planes.
+ * @param dst_planes_ Number of destination planes (size of the offsets table).
+ * @param dst_ Destination - first plane.
+ * @param plane_stride_ Distance between consecutive destination planes.
+ * @param scale_ Scale.
+ */
+template<typename T>
+inline void interleavedToPlanarScalar(const uint8_t* src_, size_t begin_, size_t end_, size_t src_channels_, const size_t* offsets_, size_t dst_planes_, T* dst_, size_t plane_stride_, T scale_) {
+	const size_t block = PIXEL_BLOCK_SIZE * PIXEL_BLOCK_SIZE;
+	for (size_t p0 = begin_; p0 < end_; p0 += block) {
+		const size_t p1 = std::min(p0 + block, end_);
+		for (size_t c = 0; c < dst_planes_; c++) {
+			const uint8_t* src_ch = src_ + offsets_[c];
+			T* dst_plane = dst_ + c * plane_stride_;
+			for (size_t p = p0; p < p1; p++)
+				dst_plane[p] = (T)src_ch[p * src_channels_] * scale_;
+		}//: for c
+	}//: for p0
+}
+
+/*!
+ * Converts interleaved 8-bit pixels (e.g. BGRBGR...) into planar real values (e.g. RR..GG..BB..), possibly reordering the channels.
+ * @tparam T Type of the output values.
+ * @param src_ Source (interleaved) pixels.
+ * @param pixels_ Number of pixels.
+ * @param src_channels_ Number of channels in the source (stride between consecutive pixels).
+ * @param offsets_ Table of offsets of source channels for consecutive destination planes.
+ * @param dst_planes_ Number of destination planes (size of the offsets table).
+ * @param dst_ Destination - first plane.
+ * @param plane_stride_ Distance between consecutive destination planes.
+ * @param scale_ Scale.
+ */
+template<typename T>
+inline void interleavedToPlanar(const uint8_t* src_, size_t pixels_, size_t src_channels_, const size_t* offsets_, size_t dst_planes_, T* dst_, size_t plane_stride_, T scale_ = (T)PIXEL_SCALE) {
+	interleavedToPlanarScalar(src_, 0, pixels_, src_channels_, offsets_, dst_planes_, dst_, plane_stride_, scale_);
+}
+
+/*!
+ * Converts interleaved 8-bit pixels into planar floats, possibly reordering the channels.
+ * With SSE2 pixels with 3 or 4 channels (RGB, BGRA etc.) are converted 4 at once: every pixel is loaded into a 32-bit lane, so every channel is extracted by a shift and a mask.
+ * The 3-channel pixels are spread into lanes with a single byte shuffle (SSSE3) or with 32-bit loads (SSE2). Other numbers of channels and the tail are converted by the scalar loops.
+ * @param src_ Source (interleaved) pixels.
+ * @param pixels_ Number of pixels.
+ * @param src_channels_ Number of channels in the source (stride between consecutive pixels).
+ * @param offsets_ Table of offsets of source channels for consecutive destination planes.
+ * @param dst_planes_ Number of destination planes (size of the offsets table).
+ * @param dst_ Destination - first plane.
+ * @param plane_stride_ Distance between consecutive destination planes.
+ * @param scale_ Scale.
+ */
+template<>
+inline void interleavedToPlanar<float>(const uint8_t* src_, size_t pixels_, size_t src_channels_, const size_t* offsets_, size_t dst_planes_, float* dst_, size_t plane_stride_, float scale_) {
+	size_t p = 0;
+#if defined(__SSE2__)
+	if ((src_channels_ == 3) || (src_channels_ == 4)) {
+		const __m128 scale = _mm_set1_ps(scale_);
+		const __m128i byte_mask = _mm_set1_epi32(0xFF);
+#if defined(__SSSE3__)
+		// Bytes 3k, 3k+1, 3k+2 of the source go to the lane k (the highest byte of the lane is zeroed).
+		const __m128i spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+#endif
+		// Every iteration reads 16 bytes (4 pixels and, for 3 channels, some bytes of the following ones).
+		for (; (p + 4) * src_channels_ + (4 - src_channels_) * 4 <= pixels_ * src_channels_; p += 4) {
+			const uint8_t* src = src_ + p * src_channels_;
+			__m128i pixels;
+			if (src_channels_ == 4)
+				pixels = _mm_loadu_si128((const __m128i*)src);
+			else {
+#if defined(__SSSE3__)
+				pixels = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), spread);
+#else
+				int32_t lanes[4];
+				for (size_t k = 0; k < 4; k++)
+					memcpy(&lanes[k], src + 3 * k, 4);
+				pixels = _mm_loadu_si128((const __m128i*)lanes);
+#endif
+			}//: else
+			for (size_t c = 0; c < dst_planes_; c++) {
+				__m128i channel = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(8 * (int)offsets_[c])), byte_mask);
+				_mm_storeu_ps(dst_ + c * plane_stride_ + p, _mm_mul_ps(_mm_cvtepi32_ps(channel), scale));
+			}//: for c
+		}//: for
+	}//: if
+#endif
+	// Scalar tail (or all pixels).
+	interleavedToPlanarScalar(src_, p, pixels_, src_channels_, offsets_, dst_planes_, dst_, plane_stride_, scale_);
+}
+
+/*!
+ * Converts planar real values (e.g. RR..GG..BB..) into interleaved ones (e.g. RGBRGB...).
+ * Pixels are processed in blocks, so every block of the destination is written from cache for all the planes.
+ * @tparam T Type of the values.
+ * @param src_ Source - first plane.
+ * @param pixels_ Number of pixels.
+ * @param channels_ Number of channels.
+ * @param plane_stride_ Distance between consecutive source planes.
+ * @param dst_ Destination (interleaved) table.
+ */
+template<typename T>
+inline void planarToInterleaved(const T* src_, size_t pixels_, size_t channels_, size_t plane_stride_, T* dst_) {
+	const size_t block = PIXEL_BLOCK_SIZE * PIXEL_BLOCK_SIZE;
+	for (size_t p0 = 0; p0 < pixels_; p0 += block) {
+		const size_t p1 = std::min(p0 + block, pixels_);
+		for (size_t c = 0; c < channels_; c++) {
+			const T* src_plane = src_ + c * plane_stride_;
+			T* dst_ch = dst_ + c;
+			for (size_t p = p0; p < p1; p++)
+				dst_ch[p * channels_] = src_plane[p];
+		}//: for c
+	}//: for p0
+}
+
+/*!
+ * Flips an image (or every plane of a planar image) vertically, in place.
+ * @tparam T Type of the values.
+ * @param data_ Image.
+ * @param rows_ Number of rows.
+ * @param row_size_ Number of elements in a row.
+ * @param planes_ Number of planes.
+ */
+template<typename T>
+inline void flipVertical(T* data_, size_t rows_, size_t row_size_, size_t planes_ = 1) {
+	if (rows_ < 2)
+		return;
+	for (size_t c = 0; c < planes_; c++) {
+		T* plane = data_ + c * rows_ * row_size_;
+		for (size_t top = 0, bottom = rows_ - 1; top < bottom; top++, bottom--)
+			std::swap_ranges(plane + top * row_size_, plane + (top + 1) * row_size_, plane + bottom * row_size_);
+	}//: for
+}
+
+/*!
+ * Converts planar 8-bit RGB pixels into grayscale real values - weighted sum of the three planes.
+ * @tparam T Type of the output values.
+ * @param src_ Source - first (red) plane.
+ * @param pixels_ Number of pixels.
+ * @param plane_stride_ Distance between consecutive source planes.
+ * @param coeffs_ Weights of the channels (e.g. CCIR 601: 0.299, 0.587, 0.114).
+ * @param dst_ Destination table.
+ * @param scale_ Scale.
+ */
+template<typename T>
+inline void planarRgbToGray(const uint8_t* src_, size_t pixels_, size_t plane_stride_, const T coeffs_[3], T* dst_, T scale_ = (T)PIXEL_SCALE) {
+	const T wr = coeffs_[0] * scale_, wg = coeffs_[1] * scale_, wb = coeffs_[2] * scale_;
+	const uint8_t* r = src_;
+	const uint8_t* g = src_ + plane_stride_;
+	const uint8_t* b = src_ + 2 * plane_stride_;
+	for (size_t i = 0; i < pixels_; i++)
+		dst_[i] = wr * r[i] + wg * g[i] + wb * b[i];
+}
+
+/*!
+ * Converts planar 8-bit RGB pixels into grayscale floats - weighted sum of the three planes. Uses AVX2 or SSE2 (if available), with a scalar tail.
+ * @param src_ Source - first (red) plane.
+ * @param pixels_ Number of pixels.
+ * @param plane_stride_ Distance between consecutive source planes.
+ * @param coeffs_ Weights of the channels (e.g. CCIR 601: 0.299, 0.587, 0.114).
+ * @param dst_ Destination table.
+ * @param scale_ Scale.
+ */
+template<>
+inline void planarRgbToGray<float>(const uint8_t* src_, size_t pixels_, size_t plane_stride_, const float coeffs_[3], float* dst_, float scale_) {
+	const float wr = coeffs_[0] * scale_, wg = coeffs_[1] * scale_, wb = coeffs_[2] * scale_;
+	const uint8_t* r = src_;
+	const uint8_t* g = src_ + plane_stride_;
+	const uint8_t* b = src_ + 2 * plane_stride_;
+	size_t i = 0;
+#if defined(__AVX2__)
+	const __m256 vr = _mm256_set1_ps(wr), vg = _mm256_set1_ps(wg), vb = _mm256_set1_ps(wb);
+	for (; i + 8 <= pixels_; i += 8) {
+		__m256 fr = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(r + i))));
+		__m256 fg = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(g + i))));
+		__m256 fb = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(b + i))));
+		__m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(fr, vr), _mm256_mul_ps(fg, vg)), _mm256_mul_ps(fb, vb));
+		_mm256_storeu_ps(dst_ + i, sum);
+	}//: for
+#elif defined(__SSE2__)
+	const __m128 vr = _mm_set1_ps(wr), vg = _mm_set1_ps(wg), vb = _mm_set1_ps(wb);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= pixels_; i += 8) {
+		// Widen 8 bytes of every plane into two vectors of 4 floats.
+		__m128i r16 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r + i)), zero);
+		__m128i g16 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(g + i)), zero);
+		__m128i b16 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(b + i)), zero);
+		__m128 lo = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(r16, zero)), vr),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(g16, zero)), vg)),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(b16, zero)), vb));
+		__m128 hi = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(r16, zero)), vr),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(g16, zero)), vg)),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(b16, zero)), vb));
+		_mm_storeu_ps(dst_ + i, lo);
+		_mm_storeu_ps(dst_ + i + 4, hi);
+	}//: for
+#endif
+	// Scalar tail.
+	for (; i < pixels_; i++)
+		dst_[i] = wr * r[i] + wg * g[i] + wb * b[i];
+}
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_PIXELKERNELS_HPP_ */
@@ -0,0 +1,209 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: PixelKernelsTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <random>
+
+#include <importers/PixelKernels.hpp>
+
+/// Lengths covering empty input, scalar-only input, full vectors and vectors followed by tails.
+const std::vector<size_t> LENGTHS = {0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100, 257};
+
+/*!
+ * Returns a vector of random bytes.
+ * @param size_ Number of bytes.
+ */
+std::vector<uint8_t> randomBytes(size_t size_) {
+	std::mt19937 rng(size_);
+	std::uniform_int_distribution<int> dist(0, 255);
+	std::vector<uint8_t> bytes(size_);
+	for (size_t i = 0; i < size_; i++)
+		bytes[i] = (uint8_t)dist(rng);
+	// Make sure the extreme values are present.
+	if (size_ > 1) {
+		bytes[0] = 255;
+		bytes[size_ - 1] = 0;
+	}//: if
+	return bytes;
+}
+
+
+/*!
+ * Compares the (vectorized) conversion of bytes with the scalar reference - also for unaligned source and destination.
+ */
+TEST(PixelKernels, U8ToReal) {
+	for (size_t n : LENGTHS) {
+		std::vector<uint8_t> src = randomBytes(n + 1);
+		std::vector<float> dst(n + 1, -1.0f);
+		std::vector<double> dst_d(n, -1.0);
+		// Shifted by one - unaligned.
+		mic::importers::u8ToReal(src.data() + 1, dst.data() + 1, n);
+		mic::importers::u8ToReal(src.data() + 1, dst_d.data(), n);
+		ASSERT_EQ(dst[0], -1.0f);
+		for (size_t i = 0; i < n; i++) {
+			ASSERT_EQ(dst[i + 1], (float)src[i + 1] * mic::importers::PIXEL_SCALE) << "n = " << n << ", i = " << i;
+			ASSERT_EQ(dst_d[i], (double)src[i + 1] * (double)mic::importers::PIXEL_SCALE);
+		}//: for
+	}//: for
+}
+
+
+/*!
+ * Compares the (vectorized and blocked) conversion of a row-major image into a column-major one with the scalar reference.
+ */
+TEST(PixelKernels, U8ToRealTransposed) {
+	std::vector<std::pair<size_t, size_t> > sizes = {{28, 28}, {33, 17}, {17, 33}, {96, 96}};
+	for (size_t rows = 1; rows < 10; rows++)
+		for (size_t cols = 1; cols < 10; cols++)
+			sizes.push_back(std::make_pair(rows, cols));
+
+	for (auto& size : sizes) {
+		const size_t rows = size.first, cols = size.second;
+		std::vector<uint8_t> src = randomBytes(rows * cols);
+		std::vector<float> dst(rows * cols, -1.0f);
+		std::vector<double> dst_d(rows * cols, -1.0);
+		mic::importers::u8ToRealTransposed(src.data(), rows, cols, dst.data());
+		mic::importers::u8ToRealTransposed(src.data(), rows, cols, dst_d.data());
+		for (size_t row = 0; row < rows; row++)
+			for (size_t col = 0; col < cols; col++) {
+				ASSERT_EQ(dst[col * rows + row], (float)src[row * cols + col] * mic::importers::PIXEL_SCALE) << rows << "x" << cols << " (" << row << "," << col << ")";
+				ASSERT_EQ(dst_d[col * rows + row], (double)src[row * cols + col] * (double)mic::importers::PIXEL_SCALE);
+			}//: for
+	}//: for
+}
+
+
+/*!
+ * Compares the (vectorized and blocked) conversion of interleaved pixels into planes with the scalar reference - with reordering of channels, also for an unaligned source.
+ */
+TEST(PixelKernels, InterleavedToPlanar) {
+	for (size_t channels : {1, 2, 3, 4, 5}) {
+		// Channels in the reversed order (e.g. BGR -> RGB), for 4 channels also with the alpha dropped.
+		std::vector<std::vector<size_t> > orders(1);
+		for (size_t c = 0; c < channels; c++)
+			orders[0].push_back(channels - 1 - c);
+		if (channels == 4)
+			orders.push_back({2, 1, 0});
+		for (auto& offsets : orders)
+			for (size_t n : LENGTHS) {
+				const size_t planes = offsets.size();
+				std::vector<uint8_t> src = randomBytes(n * channels + 1);
+				// Planes with gaps between them.
+				const size_t stride = n + 5;
+				std::vector<float> dst(planes * stride, -1.0f);
+				std::vector<double> dst_d(planes * stride, -1.0);
+				mic::importers::interleavedToPlanar(src.data() + 1, n, channels, offsets.data(), planes, dst.data(), stride);
+				mic::importers::interleavedToPlanar(src.data() + 1, n, channels, offsets.data(), planes, dst_d.data(), stride);
+				for (size_t c = 0; c < planes; c++) {
+					for (size_t p = 0; p < n; p++) {
+						const uint8_t value = src[1 + p * channels + offsets[c]];
+						ASSERT_EQ(dst[c * stride + p], (float)value * mic::importers::PIXEL_SCALE) << channels << " channels, n = " << n << " (" << c << "," << p << ")";
+						ASSERT_EQ(dst_d[c * stride + p], (double)value * (double)mic::importers::PIXEL_SCALE);
+					}//: for
+					for (size_t p = n; p < stride; p++)
+						ASSERT_EQ(dst[c * stride + p], -1.0f);
+				}//: for
+			}//: for
+	}//: for
+}
+
+
+/*!
+ * Compares the (blocked) conversion of planes into interleaved pixels with the scalar reference and checks whether it reverses interleavedToPlanar().
+ */
+TEST(PixelKernels, PlanarToInterleaved) {
+	const size_t offsets[4] = {0, 1, 2, 3};
+	for (size_t channels : {1, 3, 4}) {
+		for (size_t n : LENGTHS) {
+			std::vector<uint8_t> src = randomBytes(n * channels);
+			const size_t stride = n + 5;
+			std::vector<float> planes(channels * stride, -1.0f);
+			mic::importers::interleavedToPlanar(src.data(), n, channels, offsets, channels, planes.data(), stride, 1.0f);
+			std::vector<float> dst(n * channels + 1, -1.0f);
+			mic::importers::planarToInterleaved(planes.data(), n, channels, stride, dst.data());
+			for (size_t p = 0; p < n; p++)
+				for (size_t c = 0; c < channels; c++) {
+					ASSERT_EQ(dst[p * channels + c], planes[c * stride + p]);
+					ASSERT_EQ(dst[p * channels + c], (float)src[p * channels + c]);
+				}//: for
+			// Nothing is written past the end.
+			ASSERT_EQ(dst[n * channels], -1.0f);
+		}//: for
+	}//: for
+}
+
+
+/*!
+ * Compares the vertical flip of (multi-plane) images with the scalar reference - odd and even numbers of rows.
+ */
+TEST(PixelKernels, FlipVertical) {
+	for (size_t rows : {0, 1, 2, 5, 8})
+		for (size_t planes : {1, 3}) {
+			const size_t row_size = 7;
+			std::vector<float> image(planes * rows * row_size);
+			for (size_t i = 0; i < image.size(); i++)
+				image[i] = (float)i;
+			std::vector<float> flipped = image;
+			mic::importers::flipVertical(flipped.data(), rows, row_size, planes);
+			for (size_t c = 0; c < planes; c++)
+				for (size_t row = 0; row < rows; row++)
+					for (size_t col = 0; col < row_size; col++)
+						ASSERT_EQ(flipped[(c * rows + row) * row_size + col], image[(c * rows + rows - 1 - row) * row_size + col]) << rows << " rows, plane " << c;
+			// Flipping twice gives the original image.
+			mic::importers::flipVertical(flipped.data(), rows, row_size, planes);
+			ASSERT_EQ(flipped, image);
+		}//: for
+}
+
+
+/*!
+ * Compares the (vectorized) conversion of planar RGB into grayscale with the scalar reference.
+ */
+TEST(PixelKernels, PlanarRgbToGray) {
+	const float coeffs[3] = {0.299f, 0.587f, 0.114f};
+	const double coeffs_d[3] = {0.299, 0.587, 0.114};
+	for (size_t n : LENGTHS) {
+		const size_t stride = n + 5;
+		std::vector<uint8_t> src = randomBytes(3 * stride);
+		std::vector<float> dst(n + 1, -1.0f);
+		std::vector<double> dst_d(n, -1.0);
+		mic::importers::planarRgbToGray(src.data(), n, stride, coeffs, dst.data());
+		mic::importers::planarRgbToGray(src.data(), n, stride, coeffs_d, dst_d.data());
+		for (size_t i = 0; i < n; i++) {
+			const double expected = (coeffs_d[0] * src[i] + coeffs_d[1] * src[stride + i] + coeffs_d[2] * src[2 * stride + i]) * (double)mic::importers::PIXEL_SCALE;
+			ASSERT_NEAR(dst[i], expected, 1e-6) << "n = " << n << ", i = " << i;
+			ASSERT_NEAR(dst_d[i], expected, 1e-12);
+		}//: for
+		// Nothing is written past the end.
+		ASSERT_EQ(dst[n], -1.0f);
+	}//: for
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
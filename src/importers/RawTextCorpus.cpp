@@ -0,0 +1,103 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file RawTextCorpus.cpp
+ * \brief Contains definition of methods of a memory-mapped, byte-level text corpus.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#include <importers/RawTextCorpus.hpp>
+
+#include <logger/Log.hpp>
+
+namespace mic {
+namespace importers {
+
+RawTextCorpus::RawTextCorpus(std::string node_name_, size_t sequence_length_, size_t batch_size_) : PropertyTree(node_name_),
+	cursor(0),
+	data_filename("data_filename","data_filename"),
+	sequence_length("sequence_length", sequence_length_),
+	batch_size("batch_size", batch_size_),
+	rng_mt19937_64(rd())
+{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(data_filename);
+	registerProperty(sequence_length);
+	registerProperty(batch_size);
+
+	for (size_t i = 0; i < 256; i++)
+		char_to_index[i] = -1;
+}
+
+bool RawTextCorpus::importData() {
+	LOG(LSTATUS) << "Mapping raw text file: " << data_filename;
+	if (!file.open(data_filename)) {
+		LOG(LFATAL) << "Oops! Couldn't open file: " << data_filename;
+		return false;
+	}//: if
+
+	// Build the vocabulary - count occurrences in a single, sequential pass.
+	file.advise(true);
+	std::vector<size_t> counts(256, 0);
+	const uint8_t* ptr = file.data();
+	for (size_t i = 0; i < file.size(); i++)
+		counts[ptr[i]]++;
+	file.advise(false);
+
+	vocab.clear();
+	for (size_t c = 0; c < 256; c++) {
+		if (counts[c] > 0) {
+			char_to_index[c] = (int)vocab.size();
+			vocab.push_back((char)c);
+		} else
+			char_to_index[c] = -1;
+	}//: for
+	cursor = 0;
+
+	LOG(LINFO) << "Mapped " << size() << " characters (" << classes() << " distinct)";
+	return true;
+}
+
+void RawTextCorpus::getNextBatch(std::vector<size_t>& starts_) {
+	if ((size_t)batch_size == 0)
+		throw std::logic_error("RawTextCorpus: batch size must be greater than zero!");
+	starts_.resize(batch_size);
+	if (windows() == 0)
+		throw std::out_of_range("RawTextCorpus: text is shorter than the sequence!");
+	// Length of a segment - at least one window.
+	size_t segment = windows() / batch_size;
+	if (segment == 0)
+		segment = 1;
+	// Wrap around the segments.
+	if (cursor >= segment)
+		cursor = 0;
+	for (size_t b = 0; b < batch_size; b++)
+		starts_[b] = (b * segment + cursor) % windows();
+	cursor += sequence_length;
+}
+
+void RawTextCorpus::getRandomBatch(std::vector<size_t>& starts_) {
+	starts_.resize(batch_size);
+	if (windows() == 0)
+		throw std::out_of_range("RawTextCorpus: text is shorter than the sequence!");
+	std::uniform_int_distribution<size_t> start_dist(0, windows() - 1);
+	for (size_t b = 0; b < batch_size; b++)
+		starts_[b] = start_dist(rng_mt19937_64);
+}
+
+} /* namespace importers */
+} /* namespace mic */
@@ -0,0 +1,249 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file RawTextCorpus.hpp
+ * \brief Contains declaration of a memory-mapped, byte-level text corpus (e.g. for char-RNN training).
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_IMPORTERS_RAWTEXTCORPUS_HPP_
+#define SRC_IMPORTERS_RAWTEXTCORPUS_HPP_
+
+#include <importers/MappedFile.hpp>
+
+#include <configuration/PropertyTree.hpp>
+#include <types/Matrix.hpp>
+
+#include <vector>
+#include <utility>
+#include <random>
+#include <stdexcept>
+
+namespace mic {
+namespace importers {
+
+/*!
+ * \brief Byte-level text corpus - an alternative to RawTextImporter that maps the text file into memory instead of creating a sample per character.
+ * Characters, (input, next character) pairs and sequence windows (input: [start, start+length), target: [start+1, start+length+1)) are views of the mapped bytes.
+ * Batches are represented by positions of the windows, so creation of a batch involves no copying - the data is touched only while encoding it.
+ * \author tkornuta
+ */
+class RawTextCorpus : public mic::configuration::PropertyTree {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 * @param sequence_length_ Length of the sequence (window).
+	 * @param batch_size_ Number of sequences in the batch.
+	 */
+	RawTextCorpus(std::string node_name_ = "raw_text_corpus", size_t sequence_length_ = 25, size_t batch_size_ = 1);
+
+	/*!
+	 * Virtual destructor. Empty.
+	 */
+	virtual ~RawTextCorpus() { };
+
+	/*!
+	 * Maps the text file and builds the vocabulary (in a single, sequential pass).
+	 * @return TRUE if the file was mapped successfully, FALSE otherwise.
+	 */
+	bool importData();
+
+	/*!
+	 * Sets data filename (with path).
+	 * @param data_filename_ Path and filename
+	 */
+	void setDataFilename(std::string data_filename_) {
+		data_filename = data_filename_;
+	}
+
+	/*!
+	 * Method responsible for initialization of all variables that are property-dependent - here not required, yet empty.
+	 */
+	virtual void initializePropertyDependentVariables() { };
+
+	/// Returns the number of characters.
+	size_t size() const {
+		return file.size();
+	}
+
+	/// Returns pointer to the characters.
+	const char* data() const {
+		return (const char*)file.data();
+	}
+
+	/*!
+	 * Returns the i-th character.
+	 * @param index_ Index of the character.
+	 */
+	char character(size_t index_) const {
+		return data()[index_];
+	}
+
+	/// Returns the number of (input, next character) pairs.
+	size_t pairs() const {
+		return (size() > 0) ? size() - 1 : 0;
+	}
+
+	/*!
+	 * Returns the pair (input, next character).
+	 * @param index_ Index of the pair.
+	 */
+	std::pair<char, char> pair(size_t index_) const {
+		return std::make_pair(data()[index_], data()[index_ + 1]);
+	}
+
+	/// Returns the number of distinct characters.
+	size_t classes() const {
+		return vocab.size();
+	}
+
+	/// Returns the distinct characters (sorted by their codes).
+	const std::vector<char>& vocabulary() const {
+		return vocab;
+	}
+
+	/*!
+	 * Returns the index of the character in vocabulary (-1 if the character is not present).
+	 * @param character_ The character.
+	 */
+	int index(char character_) const {
+		return char_to_index[(uint8_t)character_];
+	}
+
+	/// Returns the length of the sequence.
+	size_t getSequenceLength() const {
+		return sequence_length;
+	}
+
+	/// Returns the number of windows (possible sequences with targets).
+	size_t windows() const {
+		return (size() > sequence_length) ? size() - sequence_length : 0;
+	}
+
+	/*!
+	 * Returns the input of the window (sequence_length characters).
+	 * @param start_ Position of the window.
+	 */
+	const char* input(size_t start_) const {
+		return data() + start_;
+	}
+
+	/*!
+	 * Returns the target of the window (sequence_length characters shifted by one).
+	 * @param start_ Position of the window.
+	 */
+	const char* target(size_t start_) const {
+		return data() + start_ + 1;
+	}
+
+	/*!
+	 * Sets the size of the batch.
+	 * @param batch_size_ Size of the batch.
+	 */
+	void setBatchSize(size_t batch_size_) {
+		batch_size = batch_size_;
+		cursor = 0;
+	}
+
+	/// Returns the size of the batch.
+	size_t getBatchSize() const {
+		return batch_size;
+	}
+
+	/*!
+	 * Returns positions of windows of the next batch. The corpus is split into batch_size segments, read in parallel and in order
+	 * (the b-th sequence of the batch is a continuation of the b-th sequence of the previous batch), as required by truncated BPTT.
+	 * If the batch size is zero throws an "std::logic_error" exception.
+	 * @param starts_ Output vector of positions.
+	 */
+	void getNextBatch(std::vector<size_t>& starts_);
+
+	/*!
+	 * Returns positions of random windows.
+	 * @param starts_ Output vector of positions.
+	 */
+	void getRandomBatch(std::vector<size_t>& starts_);
+
+	/*!
+	 * Encodes characters of the given step of the windows into one-hot matrices (vocabulary size x number of windows).
+	 * The matrices are resized only if their sizes do not match, so they can (and should) be reused across iterations.
+	 * @tparam T Type of elements.
+	 * @param starts_ Positions of windows.
+	 * @param step_ Step (from 0 to sequence_length-1).
+	 * @param inputs_ Output matrix of inputs.
+	 * @param targets_ Output matrix of targets.
+	 */
+	template<typename T>
+	void encodeStep(const std::vector<size_t>& starts_, size_t step_, mic::types::Matrix<T>& inputs_, mic::types::Matrix<T>& targets_) const {
+		if (step_ >= sequence_length)
+			throw std::out_of_range("RawTextCorpus: step out of range!");
+		inputs_.resize(classes(), starts_.size());
+		targets_.resize(classes(), starts_.size());
+		inputs_.setZero();
+		targets_.setZero();
+		for (size_t b = 0; b < starts_.size(); b++) {
+			if (starts_[b] >= windows())
+				throw std::out_of_range("RawTextCorpus: window out of range!");
+			inputs_(index(input(starts_[b])[step_]), b) = 1;
+			targets_(index(target(starts_[b])[step_]), b) = 1;
+		}//: for
+	}
+
+private:
+	/// Mapped file.
+	MappedFile file;
+
+	/// Distinct characters.
+	std::vector<char> vocab;
+
+	/// Table converting characters into their indices in the vocabulary.
+	int char_to_index[256];
+
+	/// Position of the next batch in segments.
+	size_t cursor;
+
+	/*!
+	 * Property: directory/Name of file containing data - raw text.
+	 */
+	mic::configuration::Property<std::string> data_filename;
+
+	/*!
+	 * Property: length of the sequence (window).
+	 */
+	mic::configuration::Property<size_t> sequence_length;
+
+	/*!
+	 * Property: number of sequences in the batch.
+	 */
+	mic::configuration::Property<size_t> batch_size;
+
+	/*!
+	 * Random device used for generation of random numbers.
+	 */
+	std::random_device rd;
+
+	/*!
+	 *  Mersenne Twister pseudo-random generator of 64-bit numbers.
+	 */
+	std::mt19937_64 rng_mt19937_64;
+};
+
+} /* namespace importers */
+} /* namespace mic */
+
+#endif /* SRC_IMPORTERS_RAWTEXTCORPUS_HPP_ */
@@ -21,8 +21,7 @@
  */
 
 #include <importers/RawTextImporter.hpp>
-
-#include <fstream>
+#include <importers/MappedFile.hpp>
 
 namespace mic {
 namespace importers {
@@ -40,38 +39,34 @@ void RawTextImporter::setDataFilename(std::string data_filename_) {
 
 
 bool RawTextImporter::importData(){
-	char character;
-	// Open file.
-	std::ifstream data_file(data_filename, std::ios::in | std::ios::binary);
-
 	LOG(LSTATUS) << "Importing raw data from file: " << data_filename;
 
-	// Check if file is open.
-	if (data_file.is_open()) {
-		// Iterate through the characters.
-		while(!data_file.eof()) {
-			// Read the character.
-			data_file.get(character);
-			LOG(LDEBUG) << character;
-
-			// Add character to both data and labels.
-			sample_data.push_back(std::make_shared <char> (character) );
-			sample_labels.push_back(std::make_shared <char> (character) );
-
-		}//: while ! eof
-
-		// Close the file.
-		data_file.close();
-
-	} else {
-		LOG(LFATAL) << "Oops! Couldn't find file: " << data_filename;
+	// Map the file.
+	MappedFile data_file;
+	if (!data_file.open(data_filename)) {
+		LOG(LFATAL) << "Oops! Couldn't open file: " << data_filename;
 		return false;
-	}//: else
+	}//: if
+
+	// Every distinct character is allocated once and shared by data and labels of all its occurrences (see the class description).
+	std::vector<std::shared_ptr<char> > characters(256);
+	for (size_t c = 0; c < 256; c++)
+		characters[c] = std::make_shared <char> ((char)c);
+
+	const uint8_t* ptr = data_file.data();
+	sample_data.reserve(sample_data.size() + data_file.size());
+	sample_labels.reserve(sample_labels.size() + data_file.size());
+	for (size_t i = 0; i < data_file.size(); i++) {
+		// Add character to both data and labels.
+		sample_data.push_back(characters[ptr[i]]);
+		sample_labels.push_back(characters[ptr[i]]);
+	}//: for
 
 	LOG(LINFO) << "Imported " << sample_data.size() << " characters";
 
 	// Fill the indices table(!)
-	for (size_t i=0; i < sample_data.size(); i++ )
+	sample_indices.reserve(sample_data.size());
+	for (size_t i=sample_indices.size(); i < sample_data.size(); i++ )
 		sample_indices.push_back(i);
 
 	// Count the classes.
@@ -30,6 +30,8 @@ namespace importers {
 
 /*!
  * \brief Importer responsible for importing/loading raw text files and returning characters one by one, the character denotes the label on its own.
+ * Samples alias each other: data and label of a sample, as well as all occurrences of the same character, point to one shared instance.
+ * Hence the imported characters must be treated as read-only - modifying one of them changes all of its occurrences.
  * \author tkornuta
  */
 class RawTextImporter: public mic::importers::Importer<char, char> {
@@ -0,0 +1,106 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: RawTextImportersTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <importers/RawTextImporter.hpp>
+#include <importers/RawTextCorpus.hpp>
+
+/*!
+ * Writes a text file.
+ * @param filename_ Name of the file.
+ * @param text_ Content.
+ */
+void writeText(const char* filename_, const std::string& text_) {
+	std::ofstream ofs(filename_, std::ios::binary);
+	ofs << text_;
+}
+
+
+/*!
+ * Tests whether data and labels point to one shared instance of every character.
+ */
+TEST(RawTextImporter, SharedCharacters) {
+	writeText("test-text.txt", "abca");
+	mic::importers::RawTextImporter importer;
+	importer.setDataFilename("test-text.txt");
+	ASSERT_TRUE(importer.importData());
+
+	ASSERT_EQ(importer.size(), 4);
+	ASSERT_EQ(importer.classes(), 3);
+	ASSERT_EQ(*importer.data(2), 'c');
+	ASSERT_EQ(importer.data(1).get(), importer.labels(1).get());
+	ASSERT_EQ(importer.data(0).get(), importer.data(3).get());
+	ASSERT_NE(importer.data(0).get(), importer.data(1).get());
+}
+
+
+/*!
+ * Tests whether an empty file is a valid, empty corpus - and a missing file is not.
+ */
+TEST(RawTextImporter, EmptyFile) {
+	writeText("test-empty.txt", "");
+	mic::importers::RawTextImporter importer;
+	importer.setDataFilename("test-empty.txt");
+	ASSERT_TRUE(importer.importData());
+	ASSERT_EQ(importer.size(), 0);
+
+	mic::importers::RawTextCorpus corpus("corpus", 5, 2);
+	corpus.setDataFilename("test-empty.txt");
+	ASSERT_TRUE(corpus.importData());
+	ASSERT_EQ(corpus.size(), 0);
+	ASSERT_EQ(corpus.classes(), 0);
+	std::vector<size_t> starts;
+	ASSERT_THROW(corpus.getNextBatch(starts), std::out_of_range);
+
+	importer.setDataFilename("test-missing.txt");
+	ASSERT_FALSE(importer.importData());
+	corpus.setDataFilename("test-missing.txt");
+	ASSERT_FALSE(corpus.importData());
+}
+
+
+/*!
+ * Tests whether the batch size of zero (e.g. set in the configuration file) is rejected.
+ */
+TEST(RawTextCorpus, ZeroBatchSize) {
+	writeText("test-text.txt", "abcabcabcabc");
+	mic::importers::RawTextCorpus corpus("corpus", 3, 0);
+	corpus.setDataFilename("test-text.txt");
+	ASSERT_TRUE(corpus.importData());
+	std::vector<size_t> starts;
+	ASSERT_THROW(corpus.getNextBatch(starts), std::logic_error);
+
+	corpus.setBatchSize(2);
+	corpus.getNextBatch(starts);
+	ASSERT_EQ(starts.size(), 2);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -22,6 +22,7 @@
 
 
 #include <importers/STL10MatrixImporter.hpp>
+#include <importers/PixelKernels.hpp>
 
 #include <fstream>
 
@@ -111,17 +112,9 @@ bool STL10MatrixImporter::importData(){
 
         // Create new matrix of STL-10 image size.
         mic::types::MatrixXfPtr image_ptr (new mic::types::MatrixXf(image_height, image_width));
-        image_ptr->zeros();
-
-        // Parse and set image data.
-        for (size_t j = 0 ; j < 3 ; j++) {
-            for (size_t i = 0 ; i < (size_t)(image_width*image_height) ; i++) {
-                unsigned col = i / image_width;
-                unsigned row = i % image_height;
-                //ch(row, col) = (uint8_t)buffer[i];
-                (*image_ptr)(row, col) += rgb_grayscale_coeffs[j] * (float)((uint8_t)buffer[i + ((image_height*image_width)*j)])/255.0f;
-            }//: for
-        }
+
+        // Parse and set image data - channels are stored as column-major planes, i.e. with the memory layout of the matrix.
+        mic::importers::planarRgbToGray((const uint8_t*)buffer, (size_t)(image_width*image_height), (size_t)(image_width*image_height), rgb_grayscale_coeffs, image_ptr->data());
 
         // Got the image and label.
         LOG(LDEBUG) << "Loading STL-10 sample: " << sample;
@@ -0,0 +1,159 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file AlignedMemory.hpp
+ * \brief Contains helper functions and an allocator for allocation of aligned blocks of memory.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_ALIGNEDMEMORY_HPP_
+#define SRC_TYPES_ALIGNEDMEMORY_HPP_
+
+#include <cstdlib>
+#include <cstddef>
+#include <new> // std::bad_alloc
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Default alignment (in bytes) of data blocks - equal to the size of cache line (and the width of AVX-512 registers).
+ * \author tkornuta
+ */
+const size_t DEFAULT_MEMORY_ALIGNMENT = 64;
+
+/*!
+ * Rounds the size (in bytes) up to the nearest multiple of alignment.
+ * @param bytes_ Size of the block (in bytes).
+ * @param alignment_ Alignment (must be a power of two).
+ * @return Aligned size.
+ */
+inline size_t alignedSize(size_t bytes_, size_t alignment_ = DEFAULT_MEMORY_ALIGNMENT) {
+	return (bytes_ + alignment_ - 1) & ~(alignment_ - 1);
+}
+
+/*!
+ * Allocates an aligned block of memory. Throws std::bad_alloc if allocation failed.
+ * @param bytes_ Size of the block (in bytes).
+ * @param alignment_ Alignment (must be a power of two and multiple of sizeof(void*)).
+ * @return Pointer to the allocated block. Must be released with alignedFree().
+ */
+inline void* alignedMalloc(size_t bytes_, size_t alignment_ = DEFAULT_MEMORY_ALIGNMENT) {
+	// Always allocate at least one aligned block.
+	bytes_ = alignedSize((bytes_ > 0) ? bytes_ : 1, alignment_);
+	void* ptr = nullptr;
+#ifdef _WIN32
+	ptr = _aligned_malloc(bytes_, alignment_);
+#else
+	if (posix_memalign(&ptr, alignment_, bytes_) != 0)
+		ptr = nullptr;
+#endif
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+/*!
+ * Frees the block of memory allocated with alignedMalloc().
+ * @param ptr_ Pointer to the block (can be nullptr).
+ */
+inline void alignedFree(void* ptr_) {
+	if (ptr_ == nullptr)
+		return;
+#ifdef _WIN32
+	_aligned_free(ptr_);
+#else
+	free(ptr_);
+#endif
+}
+
+
+/*!
+ * \brief Tag used for construction of containers (e.g. tensors) with uninitialized elements.
+ * \author tkornuta
+ */
+struct UninitializedTag { };
+
+/// Tag passed to constructors in order to skip initialization of elements.
+const UninitializedTag UNINITIALIZED = UninitializedTag();
+
+/*!
+ * \brief Allocator returning aligned blocks of memory - satisfies requirements of standard allocators, so it can be used e.g. in std::vector.
+ * Note: it does not construct nor destroy objects in allocate/deallocate, hence it is intended for plain data types.
+ * \author tkornuta
+ * \tparam T Type of elements.
+ * \tparam Alignment Alignment in bytes (must be a power of two and multiple of sizeof(void*)).
+ */
+template<typename T, size_t Alignment = DEFAULT_MEMORY_ALIGNMENT>
+class AlignedAllocator {
+public:
+	/// Type of allocated elements.
+	typedef T value_type;
+
+	/*!
+	 * \brief Allocator of a different type with the same alignment.
+	 */
+	template<typename U>
+	struct rebind {
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	/// Default constructor.
+	AlignedAllocator() { }
+
+	/// Copy constructor from allocator of a different type.
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) { }
+
+	/*!
+	 * Allocates an aligned block for a given number of elements.
+	 * @param n_ Number of elements.
+	 * @return Pointer to the block.
+	 */
+	T* allocate(size_t n_) {
+		return static_cast<T*>(alignedMalloc(n_ * sizeof(T), Alignment));
+	}
+
+	/*!
+	 * Frees the block.
+	 * @param ptr_ Pointer to the block.
+	 */
+	void deallocate(T* ptr_, size_t) {
+		alignedFree(ptr_);
+	}
+
+	/// All aligned allocators are equal (stateless).
+	template<typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const {
+		return true;
+	}
+
+	/// All aligned allocators are equal (stateless).
+	template<typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+		return false;
+	}
+};
+
+} //: namespace types
+} //: namespace mic
+
+#endif /* SRC_TYPES_ALIGNEDMEMORY_HPP_ */
@@ -24,15 +24,45 @@
 #define SRC_TYPES_BATCH_HPP_
 
 #include <types/Sample.hpp>
+#include <types/BatchView.hpp>
+#include <types/RandomFill.hpp>
 
 #include <random>
-
-#include <list>
+#include <map>
+#include <algorithm>
 
 
 namespace mic {
 namespace types {
 
+/*!
+ * \brief Policy of handling the last, partial batch of an epoch (i.e. when the number of samples is not divisible by the batch size).
+ * \author tkornuta
+ */
+enum class LastBatchPolicy {
+	Drop, ///< The remaining samples are skipped in the current epoch.
+	Pad, ///< The batch is completed with samples from the beginning of the epoch permutation.
+	Partial ///< A smaller batch is returned.
+};
+
+
+/*!
+ * \brief Cursor of the epoch iterator - stores everything required to resume the iteration (e.g. from a checkpoint).
+ * The permutation of an epoch is a function of seed and epoch number, so it is not stored.
+ * \author tkornuta
+ */
+struct EpochCursor {
+	/// Seed of permutations.
+	uint64_t seed;
+
+	/// Number of the current epoch.
+	uint64_t epoch;
+
+	/// Position in the permutation of the current epoch.
+	size_t position;
+};
+
+
 /*!
  * \brief Template class storing the sample batches.
  * A batch is stored in fact as three vectors, containing data, labels and sample numbers respectively.
@@ -49,7 +79,13 @@ public:
 	Batch(size_t batch_size_ = 1) :
 		next_sample_index(0),
 		batch_size(batch_size_),
-		rng_mt19937_64(rd())
+		rng_mt19937_64(rd()),
+		number_of_classes(0),
+		indexed_samples(0),
+		last_batch_policy(LastBatchPolicy::Drop),
+		epoch_seed(mic::types::getRandomSeed()),
+		epoch(0),
+		epoch_position(0)
 	{
 
 	}
@@ -59,7 +95,11 @@ public:
 	 * @param batch_ Batch to be copied.
 	 */
 	Batch(const mic::types::Batch<DataType, LabelType>& batch_) :
-		rng_mt19937_64(rd())
+		rng_mt19937_64(rd()),
+		last_batch_policy(batch_.last_batch_policy),
+		epoch_seed(batch_.epoch_seed),
+		epoch(batch_.epoch),
+		epoch_position(batch_.epoch_position)
 	{
 		// Copy parameters.
 		next_sample_index = batch_.next_sample_index;
@@ -71,6 +111,9 @@ public:
 		this->sample_indices = batch_.sample_indices;
 		// And number of classes.
 		this->number_of_classes = batch_.number_of_classes;
+		// Copy the index of classes.
+		this->class_positions = batch_.class_positions;
+		this->indexed_samples = batch_.indexed_samples;
 	}
 
 	/*!
@@ -85,6 +128,16 @@ public:
 		this->sample_indices = batch_.sample_indices;
 		// And number of classes.
 		this->number_of_classes = batch_.number_of_classes;
+		// Copy the index of classes.
+		this->class_positions = batch_.class_positions;
+		this->indexed_samples = batch_.indexed_samples;
+		// Copy the state of the epoch iterator - the permutation will be regenerated from seed and epoch.
+		this->last_batch_policy = batch_.last_batch_policy;
+		this->epoch_seed = batch_.epoch_seed;
+		this->epoch = batch_.epoch;
+		this->epoch_position = batch_.epoch_position;
+		if (this != &batch_)
+			this->epoch_permutation.clear();
 		// Return the object.
 		return *this;
 	}
@@ -132,7 +185,7 @@ public:
 	 * @param index_ Index of the sample from the batch.
 	 * @return Sample number.
 	 */
-	std::vector <size_t> indices(size_t index_) {
+	size_t indices(size_t index_) {
 		return sample_indices[index_];
 	}
 
@@ -144,6 +197,16 @@ public:
 		return sample_data.size();
 	}
 
+	/*!
+	 * Reserves memory for a given number of samples, so consecutive add() calls will not reallocate the vectors.
+	 * @param size_ Number of samples.
+	 */
+	void reserve(size_t size_) {
+		sample_data.reserve(size_);
+		sample_labels.reserve(size_);
+		sample_indices.reserve(size_);
+	}
+
 	/*!
 	 * Sets the batch size.
 	 * @param batch_size_ Batch size.
@@ -171,6 +234,7 @@ public:
 		std::uniform_int_distribution<> index_dist(0, this->sample_data.size()-1);
 
 		std::vector<size_t> tmp_indices;
+		tmp_indices.reserve(batch_size);
 		for (size_t i=0; i<batch_size; i++) {
 			// Pick an index.
 			tmp_indices.push_back((size_t)index_dist(rng_mt19937_64));
@@ -197,6 +261,7 @@ public:
 		}
 		// Generate list of indices.
 		std::vector<size_t> indices;
+		indices.reserve(batch_size);
 		for (size_t i=0; i<batch_size; i++) {
 			// Pick an index.
 			indices.push_back((size_t)(next_sample_index+i));
@@ -216,10 +281,11 @@ public:
 	 * @param indices_ Vector of indices
 	 * @return Batch - a pair of vectors of <shared pointers to samples> / vectors of <shared pointers to labels>, supplemented by third vector containing sample numbers.
 	 */
-	mic::types::Batch<DataType, LabelType> getBatch(std::vector<size_t> indices_) {
+	mic::types::Batch<DataType, LabelType> getBatch(const std::vector<size_t>& indices_) {
 
 		// New empty batch.
 		mic::types::Batch<DataType, LabelType> batch;
+		batch.reserve(indices_.size());
 		// Set number of classes.
 		batch.number_of_classes = number_of_classes;
 
@@ -239,10 +305,11 @@ public:
 	 * @param indices_ Vector of indices
 	 * @return Batch - a pair of vectors of <shared pointers to samples> / vectors of <shared pointers to labels>, supplemented by third vector containing sample numbers.
 	 */
-	mic::types::Batch<DataType, LabelType> getBatchDirect(std::vector<size_t> indices_) {
+	mic::types::Batch<DataType, LabelType> getBatchDirect(const std::vector<size_t>& indices_) {
 
 		// New empty batch.
 		mic::types::Batch<DataType, LabelType> batch;
+		batch.reserve(indices_.size());
 
 		// For all indices.
 		for (size_t local_index: indices_) {
@@ -254,6 +321,182 @@ public:
 	}
 
 
+	/*!
+	 * Returns a view of batch of random samples (with replacement) - analogue of getRandomBatch() that does not copy samples.
+	 * Positions of samples are stored in a buffer reused by consecutive calls, hence the returned view is valid only until the next call.
+	 * If the batch is empty throws an "std::logic_error" exception.
+	 * @return View of the batch.
+	 */
+	mic::types::BatchView<DataType, LabelType> getRandomBatchView() {
+		if (this->sample_data.empty())
+			throw std::logic_error("Cannot draw samples from an empty batch!");
+
+		// Initialize uniform index distribution - integers.
+		std::uniform_int_distribution<size_t> index_dist(0, this->sample_data.size()-1);
+
+		// Reuse the buffer.
+		view_positions.resize(batch_size);
+		for (size_t i=0; i<batch_size; i++) {
+			// Pick an index.
+			view_positions[i] = index_dist(rng_mt19937_64);
+		}//: batch_size
+
+		return mic::types::BatchView<DataType, LabelType>(this, view_positions.data(), batch_size);
+	}
+
+
+	/*!
+	 * Iterates through samples and returns views of consecutive batches - analogue of getNextBatch() that does not copy samples.
+	 * After returning the last possible batch from the dataset the procedure starts from the beginning.
+	 * If the batch size is zero or greater than the number of samples throws an "std::logic_error" exception.
+	 * @return View of the batch - span of consecutive samples.
+	 */
+	mic::types::BatchView<DataType, LabelType> getNextBatchView() {
+		if ((batch_size == 0) || (batch_size > this->sample_data.size()))
+			throw std::logic_error("Batch size exceeds the number of samples!");
+
+		// Check index.
+		if((next_sample_index+batch_size) > this->sample_data.size()){
+			// Reset index.
+			next_sample_index = 0;
+		}
+		mic::types::BatchView<DataType, LabelType> view(this, next_sample_index, batch_size);
+
+		// Increment index.
+		next_sample_index += batch_size;
+		return view;
+	}
+
+
+	/*!
+	 * Sets the policy of handling the last, partial batch of an epoch.
+	 * @param policy_ Policy (DEFAULT=Drop).
+	 */
+	void setLastBatchPolicy(LastBatchPolicy policy_) {
+		last_batch_policy = policy_;
+	}
+
+	/*!
+	 * Sets the seed of epoch permutations and restarts the iteration from the beginning of the first epoch.
+	 * @param seed_ Seed.
+	 */
+	void setEpochSeed(uint64_t seed_) {
+		setEpochCursor({seed_, 0, 0});
+	}
+
+	/*!
+	 * Returns the cursor of the epoch iterator, which can be stored and then used for resuming the iteration.
+	 * @return Cursor.
+	 */
+	EpochCursor getEpochCursor() const {
+		return {epoch_seed, epoch, epoch_position};
+	}
+
+	/*!
+	 * Resumes the epoch iteration from a given cursor - regenerates the permutation of the epoch.
+	 * @param cursor_ Cursor.
+	 */
+	void setEpochCursor(const EpochCursor& cursor_) {
+		epoch_seed = cursor_.seed;
+		epoch = cursor_.epoch;
+		epoch_position = cursor_.position;
+		// Force regeneration of the permutation.
+		epoch_permutation.clear();
+	}
+
+	/*!
+	 * Returns the number of the current epoch.
+	 */
+	uint64_t getEpoch() const {
+		return epoch;
+	}
+
+	/*!
+	 * Returns the number of batches in an epoch, according to the last batch policy.
+	 */
+	size_t epochBatches() {
+		size_t n = this->sample_data.size();
+		if (batch_size == 0)
+			return 0;
+		return (last_batch_policy == LastBatchPolicy::Drop) ? n / batch_size : (n + batch_size - 1) / batch_size;
+	}
+
+	/*!
+	 * Checks if the current epoch has ended, i.e. the next call of getNextEpochBatchView() will start a new epoch.
+	 * @return True if there are no more batches in the current epoch.
+	 */
+	bool isEpochFinished() {
+		size_t n = this->sample_data.size();
+		if (last_batch_policy == LastBatchPolicy::Drop)
+			return (epoch_position + batch_size > n);
+		return (epoch_position >= n);
+	}
+
+	/*!
+	 * Returns a view of the next batch of the epoch. Every epoch visits all samples in the order of a single Fisher-Yates permutation, thus the samples are drawn without replacement.
+	 * The last, partial batch is handled according to the last batch policy. When the epoch ends the next one (with a new permutation) is started.
+	 * The view points to the internal buffer, hence it is valid only until the next call.
+	 * If the batch size is zero or (with the Drop policy) greater than the number of samples throws an "std::logic_error" exception.
+	 * @return View of the batch.
+	 */
+	mic::types::BatchView<DataType, LabelType> getNextEpochBatchView() {
+		if ((batch_size == 0) || (epochBatches() == 0))
+			throw std::logic_error("Epoch contains no batches!");
+
+		// Start the next epoch.
+		if (isEpochFinished()) {
+			epoch++;
+			epoch_position = 0;
+			epoch_permutation.clear();
+		}//: if
+		// Generate the permutation (lazily, so it also handles resuming and samples added in the meantime).
+		if (epoch_permutation.size() != this->sample_data.size())
+			shuffleEpoch();
+
+		const size_t n = epoch_permutation.size();
+		const size_t remaining = n - epoch_position;
+		mic::types::BatchView<DataType, LabelType> view;
+		if (remaining >= batch_size) {
+			// Full batch - a span of the permutation, no copying.
+			view = mic::types::BatchView<DataType, LabelType>(this, epoch_permutation.data() + epoch_position, batch_size);
+		} else if (last_batch_policy == LastBatchPolicy::Partial) {
+			view = mic::types::BatchView<DataType, LabelType>(this, epoch_permutation.data() + epoch_position, remaining);
+		} else {
+			// Pad - take the missing samples from the beginning of the permutation.
+			view_positions.resize(batch_size);
+			for (size_t i = 0; i < batch_size; i++)
+				view_positions[i] = epoch_permutation[(epoch_position + i) % n];
+			view = mic::types::BatchView<DataType, LabelType>(this, view_positions.data(), batch_size);
+		}//: else
+
+		epoch_position += std::min(remaining, (size_t)batch_size);
+		return view;
+	}
+
+	/*!
+	 * Returns the next batch of the epoch - analogue of getNextEpochBatchView() that copies the samples.
+	 * @return Batch - a pair of vectors of <shared pointers to samples> / vectors of <shared pointers to labels>, supplemented by third vector containing sample numbers.
+	 */
+	mic::types::Batch<DataType, LabelType> getNextEpochBatch() {
+		mic::types::BatchView<DataType, LabelType> view = getNextEpochBatchView();
+		std::vector<size_t> positions(view.size());
+		for (size_t i = 0; i < view.size(); i++)
+			positions[i] = view.position(i);
+		return this->getBatchDirect(positions);
+	}
+
+
+	/*!
+	 * Returns a view of samples with given positions in the batch - analogue of getBatchDirect() that does not copy samples.
+	 * The vector of positions is not copied, thus it must outlive the view.
+	 * @param positions_ Vector of positions.
+	 * @return View of the batch.
+	 */
+	mic::types::BatchView<DataType, LabelType> getBatchView(const std::vector<size_t>& positions_) {
+		return mic::types::BatchView<DataType, LabelType>(this, positions_.data(), positions_.size());
+	}
+
+
 	/*!
 	 * Checks if the returned batch was the last possible one.
 	 * @return True if the batch was the last one.
@@ -407,17 +650,129 @@ public:
 	}
 
 	/*!
-	 * Counts the distinctive classes.
-	 * Quite slow method, but works.
+	 * Counts the distinctive classes - updates the index of classes (only with the samples added since the last update) and takes its size.
 	 */
 	void countClasses() {
-		std::list<LabelType> classes;
-		for(auto label: this->sample_labels) {
-			classes.push_back(*label);
+		updateClassIndex();
+		this->number_of_classes = class_positions.size();
+	}
+
+	/*!
+	 * Updates the index of classes (positions of samples of every class). The index is updated incrementally - only with the samples added since the previous update.
+	 * If the samples were removed or the batch was shrunk the index is rebuilt. Note: changes of labels of already indexed samples are not detected.
+	 */
+	void updateClassIndex() {
+		if (indexed_samples > sample_labels.size()) {
+			class_positions.clear();
+			indexed_samples = 0;
+		}//: if
+		for (; indexed_samples < sample_labels.size(); indexed_samples++)
+			class_positions[*sample_labels[indexed_samples]].push_back(indexed_samples);
+	}
+
+	/*!
+	 * Returns the index of classes - positions of samples of every class.
+	 * @return Map from label to vector of positions.
+	 */
+	const std::map<LabelType, std::vector<size_t> >& classIndex() {
+		updateClassIndex();
+		return class_positions;
+	}
+
+	/*!
+	 * Returns the histogram of labels - number of samples of every class.
+	 * @return Map from label to number of samples.
+	 */
+	std::map<LabelType, size_t> classHistogram() {
+		updateClassIndex();
+		std::map<LabelType, size_t> histogram;
+		for (auto& cls: class_positions)
+			histogram[cls.first] = cls.second.size();
+		return histogram;
+	}
+
+	/*!
+	 * Returns a view of batch of samples with classes chosen uniformly (class-balanced sampling) - samples of every class are then picked randomly (with replacement).
+	 * Positions of samples are stored in a buffer reused by consecutive calls, hence the returned view is valid only until the next call.
+	 * If the batch is empty throws an "std::logic_error" exception.
+	 * @return View of the batch.
+	 */
+	mic::types::BatchView<DataType, LabelType> getBalancedBatchView() {
+		if (sample_labels.empty())
+			throw std::logic_error("Cannot draw samples from an empty batch!");
+
+		updateClassIndex();
+		classes_buffer.clear();
+		for (auto& cls: class_positions)
+			classes_buffer.push_back(&cls.second);
+
+		std::uniform_int_distribution<size_t> class_dist(0, classes_buffer.size()-1);
+		view_positions.resize(batch_size);
+		for (size_t i=0; i<batch_size; i++) {
+			const std::vector<size_t>& positions = *classes_buffer[class_dist(rng_mt19937_64)];
+			std::uniform_int_distribution<size_t> position_dist(0, positions.size()-1);
+			view_positions[i] = positions[position_dist(rng_mt19937_64)];
+		}//: batch_size
+
+		return mic::types::BatchView<DataType, LabelType>(this, view_positions.data(), batch_size);
+	}
+
+	/*!
+	 * Returns a batch of samples with classes chosen uniformly (class-balanced sampling).
+	 * @return Batch - a pair of vectors of <shared pointers to samples> / vectors of <shared pointers to labels>, supplemented by third vector containing sample numbers.
+	 */
+	mic::types::Batch<DataType, LabelType> getBalancedBatch() {
+		return getBalancedBatchView().materialize();
+	}
+
+	/*!
+	 * Returns a view of batch in which every class is represented proportionally to its share in the dataset (stratified sampling).
+	 * The number of samples of a class is the rounded down share, remaining samples are assigned to classes with the biggest remainders. Samples of every class are picked randomly (with replacement).
+	 * Positions of samples are stored in a buffer reused by consecutive calls, hence the returned view is valid only until the next call.
+	 * If the batch is empty throws an "std::logic_error" exception.
+	 * @return View of the batch.
+	 */
+	mic::types::BatchView<DataType, LabelType> getStratifiedBatchView() {
+		if (sample_labels.empty())
+			throw std::logic_error("Cannot draw samples from an empty batch!");
+
+		updateClassIndex();
+		const size_t total = sample_labels.size();
+		classes_buffer.clear();
+		std::vector<size_t> counts;
+		std::vector<std::pair<size_t, size_t> > remainders;
+		size_t assigned = 0;
+		for (auto& cls: class_positions) {
+			// Use integer arithmetics - number of samples and remainder.
+			size_t share = cls.second.size() * batch_size;
+			remainders.push_back(std::make_pair(share % total, classes_buffer.size()));
+			counts.push_back(share / total);
+			assigned += share / total;
+			classes_buffer.push_back(&cls.second);
+		}//: for
+		// Assign the remaining samples.
+		std::sort(remainders.begin(), remainders.end(), [](const std::pair<size_t, size_t>& a_, const std::pair<size_t, size_t>& b_) { return a_.first > b_.first; });
+		for (size_t i = 0; assigned < batch_size; i++, assigned++)
+			counts[remainders[i % remainders.size()].second]++;
+
+		view_positions.resize(batch_size);
+		size_t pos = 0;
+		for (size_t c = 0; c < classes_buffer.size(); c++) {
+			const std::vector<size_t>& positions = *classes_buffer[c];
+			std::uniform_int_distribution<size_t> position_dist(0, positions.size()-1);
+			for (size_t i = 0; i < counts[c]; i++)
+				view_positions[pos++] = positions[position_dist(rng_mt19937_64)];
 		}//: for
-		classes.sort();
-		classes.unique();
-		this->number_of_classes = classes.size();
+
+		return mic::types::BatchView<DataType, LabelType>(this, view_positions.data(), batch_size);
+	}
+
+	/*!
+	 * Returns a batch in which every class is represented proportionally to its share in the dataset (stratified sampling).
+	 * @return Batch - a pair of vectors of <shared pointers to samples> / vectors of <shared pointers to labels>, supplemented by third vector containing sample numbers.
+	 */
+	mic::types::Batch<DataType, LabelType> getStratifiedBatch() {
+		return getStratifiedBatchView().materialize();
 	}
 
 	/*!
@@ -428,6 +783,28 @@ public:
 		return number_of_classes;
 	}
 
+protected:
+	/*!
+	 * Generates the permutation of samples of the current epoch with the Fisher-Yates shuffle.
+	 * Random numbers come from the counter-based generator (stream = epoch), so the permutation depends only on seed and epoch number.
+	 */
+	void shuffleEpoch() {
+		const size_t n = this->sample_data.size();
+		epoch_permutation.resize(n);
+		for (size_t i = 0; i < n; i++)
+			epoch_permutation[i] = i;
+
+		uint32_t r[4];
+		for (size_t i = n; i > 1; i--) {
+			const size_t k = n - i;
+			if (k % 4 == 0)
+				mic::types::Philox4x32::generate(k / 4, epoch, epoch_seed, r);
+			// Map 32 random bits into range <0, i) - multiply and shift.
+			size_t j = (size_t)(((uint64_t)r[k % 4] * i) >> 32);
+			std::swap(epoch_permutation[i-1], epoch_permutation[j]);
+		}//: for
+	}
+
 protected:
 	/*!
 	 * Index of the returned sample - it is used ONLY in getNextSample (i.e. iterative, not random sampling) method.
@@ -459,11 +836,38 @@ protected:
 	/// Stores sample indices (sample "positions" in original dataset).
 	std::vector <size_t> sample_indices;
 
+	/// Buffer storing positions of samples returned by getRandomBatchView().
+	std::vector <size_t> view_positions;
+
 	/*!
 	 * Number of distinctive classes in the (main) dataset.
 	 */
 	size_t number_of_classes;
 
+	/// Index of classes - positions of samples of every class.
+	std::map<LabelType, std::vector<size_t> > class_positions;
+
+	/// Number of samples already added to the index of classes.
+	size_t indexed_samples;
+
+	/// Buffer storing pointers to vectors of positions of classes, used by class-based sampling.
+	std::vector<const std::vector<size_t>* > classes_buffer;
+
+	/// Policy of handling the last, partial batch of an epoch.
+	LastBatchPolicy last_batch_policy;
+
+	/// Seed of epoch permutations.
+	uint64_t epoch_seed;
+
+	/// Number of the current epoch.
+	uint64_t epoch;
+
+	/// Position in the permutation of the current epoch.
+	size_t epoch_position;
+
+	/// Permutation of samples of the current epoch.
+	std::vector <size_t> epoch_permutation;
+
 };
 
 
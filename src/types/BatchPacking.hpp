@@ -0,0 +1,184 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BatchPacking.hpp
+ * \brief Contains functions packing samples of a batch into dense, preallocated matrices and tensors.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_BATCHPACKING_HPP_
+#define SRC_TYPES_BATCHPACKING_HPP_
+
+#include <types/Matrix.hpp>
+#include <types/Tensor.hpp>
+#include <types/SampleArena.hpp>
+
+#include <vector>
+#include <cstring> // memcpy
+#include <stdexcept>
+
+namespace mic {
+namespace types {
+
+/*!
+ * Packs data of all samples of a batch (or batch view) into a matrix (features x batch size), one sample per column.
+ * The samples are copied block by block with memcpy - there are no per-sample allocations.
+ * The matrix is resized only if its size does not match, so it can (and should) be reused across iterations. For an empty source the matrix has no columns.
+ * If the samples differ in size throws an "std::invalid_argument" exception.
+ * @tparam SourceType Type of the source - Batch or BatchView of Matrix<T> or Tensor<T> samples.
+ * @tparam T Type of elements.
+ * @param source_ Source batch (or view).
+ * @param out_ Output matrix.
+ */
+template<typename SourceType, typename T>
+void packSamples(SourceType& source_, mic::types::Matrix<T>& out_) {
+	const size_t batch_size = source_.size();
+	// Empty source - no columns (the number of rows is kept, as the size of samples is unknown).
+	if (batch_size == 0) {
+		out_.resize(out_.rows(), 0);
+		return;
+	}//: if
+	const size_t sample_size = source_.data(0)->size();
+
+	// Resize the output - noop if the size is correct.
+	out_.resize(sample_size, batch_size);
+	T* out_ptr = out_.data();
+
+	// Check sizes first, so the copy loop can be parallelized.
+	for (size_t i = 0; i < batch_size; i++) {
+		if ((size_t)source_.data(i)->size() != sample_size)
+			throw std::invalid_argument("packSamples: samples differ in size!");
+	}//: for
+
+#pragma omp parallel for if(mic::types::useParallel(batch_size * sample_size))
+	for (size_t i = 0; i < batch_size; i++) {
+		memcpy(out_ptr + i * sample_size, source_.data(i)->data(), sample_size * sizeof(T));
+	}//: for
+}
+
+
+/*!
+ * Packs data of all samples of a batch (or batch view) into a tensor.
+ * The tensor has dimensions of the first sample extended by batch size as the last dimension - as the 0th dimension of tensor is the fastest changing one, every sample is a contiguous block of memory.
+ * The tensor is reallocated only if its number of elements does not match, so it can (and should) be reused across iterations. For an empty source the tensor is empty.
+ * If the samples differ in size throws an "std::invalid_argument" exception.
+ * @tparam SourceType Type of the source - Batch or BatchView of Tensor<T> samples.
+ * @tparam T Type of elements.
+ * @param source_ Source batch (or view).
+ * @param out_ Output tensor.
+ */
+template<typename SourceType, typename T>
+void packSamples(SourceType& source_, mic::types::Tensor<T>& out_) {
+	const size_t batch_size = source_.size();
+	// Empty source - empty tensor (dimensions of samples are unknown).
+	if (batch_size == 0) {
+		out_ = mic::types::Tensor<T>();
+		return;
+	}//: if
+	const size_t sample_size = source_.data(0)->size();
+
+	// Set output dimensions - reallocates only if the number of elements changes.
+	std::vector<size_t> dims = source_.data(0)->dims();
+	dims.push_back(batch_size);
+	out_.resize(dims);
+	T* out_ptr = out_.data();
+
+	// Check sizes first, so the copy loop can be parallelized.
+	for (size_t i = 0; i < batch_size; i++) {
+		if ((size_t)source_.data(i)->size() != sample_size)
+			throw std::invalid_argument("packSamples: samples differ in size!");
+	}//: for
+
+#pragma omp parallel for if(mic::types::useParallel(batch_size * sample_size))
+	for (size_t i = 0; i < batch_size; i++) {
+		memcpy(out_ptr + i * sample_size, source_.data(i)->data(), sample_size * sizeof(T));
+	}//: for
+}
+
+
+/*!
+ * Packs selected samples of an arena into a matrix (features x number of samples), one sample per column.
+ * The matrix is resized only if its size does not match, so it can (and should) be reused across iterations.
+ * @tparam T Type of elements.
+ * @tparam LabelType Type of labels.
+ * @param arena_ Source arena.
+ * @param positions_ Table of positions of samples in the arena.
+ * @param size_ Number of samples.
+ * @param out_ Output matrix.
+ */
+template<typename T, typename LabelType>
+void packSamples(mic::types::SampleArena<T, LabelType>& arena_, const size_t* positions_, size_t size_, mic::types::Matrix<T>& out_) {
+	const size_t sample_size = arena_.sampleSize();
+
+	// Resize the output - noop if the size is correct.
+	out_.resize(sample_size, size_);
+	T* out_ptr = out_.data();
+
+#pragma omp parallel for if(mic::types::useParallel(size_ * sample_size))
+	for (size_t i = 0; i < size_; i++) {
+		memcpy(out_ptr + i * sample_size, arena_.data(positions_[i]), sample_size * sizeof(T));
+	}//: for
+}
+
+
+/*!
+ * Packs labels of all samples of a batch (or batch view) into a vector.
+ * The vector is reallocated only if its capacity is too small, so it can (and should) be reused across iterations.
+ * @tparam SourceType Type of the source - Batch or BatchView.
+ * @tparam LabelType Type of labels.
+ * @param source_ Source batch (or view).
+ * @param out_ Output vector.
+ */
+template<typename SourceType, typename LabelType>
+void packLabels(SourceType& source_, std::vector<LabelType>& out_) {
+	out_.resize(source_.size());
+	for (size_t i = 0; i < out_.size(); i++)
+		out_[i] = *(source_.labels(i));
+}
+
+
+/*!
+ * Packs labels of all samples of a batch (or batch view) into a matrix (number of classes x batch size) using 1-of-k encoding.
+ * The matrix is resized only if its size does not match, so it can (and should) be reused across iterations.
+ * If any label is out of range throws an "std::out_of_range" exception.
+ * @tparam SourceType Type of the source - Batch or BatchView with integer labels.
+ * @tparam T Type of elements.
+ * @param source_ Source batch (or view).
+ * @param classes_ Number of classes.
+ * @param out_ Output matrix.
+ */
+template<typename SourceType, typename T>
+void packOneHot(SourceType& source_, size_t classes_, mic::types::Matrix<T>& out_) {
+	const size_t batch_size = source_.size();
+
+	// Resize the output - noop if the size is correct.
+	out_.resize(classes_, batch_size);
+	out_.setZero();
+
+	for (size_t i = 0; i < batch_size; i++) {
+		size_t label = (size_t)*(source_.labels(i));
+		if (label >= classes_)
+			throw std::out_of_range("packOneHot: label out of range!");
+		out_(label, i) = 1;
+	}//: for
+}
+
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_BATCHPACKING_HPP_ */
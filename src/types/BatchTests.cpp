@@ -0,0 +1,353 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: BatchTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+// Redefine words "private" and "protected" so every class field/method will be accessible for tests.
+#define private public
+#define protected public
+#include <types/Batch.hpp>
+#include <types/BatchPacking.hpp>
+
+/*!
+ * Creates a batch of N <int, unsigned int> samples, where sample i has data i*10 and label i%10.
+ */
+mic::types::Batch<int, unsigned int> createBatch(size_t N_, size_t batch_size_) {
+	mic::types::Batch<int, unsigned int> batch(batch_size_);
+	for (size_t i = 0; i < N_; i++)
+		batch.add(std::make_shared<int>(i*10), std::make_shared<unsigned int>(i%10));
+	return batch;
+}
+
+
+/*!
+ * Tests whether views of consecutive batches point to the same samples as the copied batches.
+ */
+TEST(Batch, NextBatchView) {
+	mic::types::Batch<int, unsigned int> batch = createBatch(10, 4);
+
+	auto view = batch.getNextBatchView();
+	ASSERT_EQ(view.size(), 4);
+	for (size_t i = 0; i < 4; i++) {
+		ASSERT_EQ(view.data(i).get(), batch.data(i).get());
+		ASSERT_EQ(*view.labels(i), i%10);
+		ASSERT_EQ(view.indices(i), i);
+	}//: for
+
+	// Second view.
+	view = batch.getNextBatchView();
+	ASSERT_EQ(*view.data(0), 40);
+
+	// Third batch would overflow - start from the beginning.
+	view = batch.getNextBatchView();
+	ASSERT_EQ(*view.data(0), 0);
+}
+
+
+/*!
+ * Tests iteration through a view.
+ */
+TEST(Batch, BatchViewIteration) {
+	mic::types::Batch<int, unsigned int> batch = createBatch(10, 1);
+
+	std::vector<size_t> positions = {9, 3, 5};
+	auto view = batch.getBatchView(positions);
+
+	size_t i = 0;
+	for (auto sample : view) {
+		ASSERT_EQ(*sample.data(), positions[i]*10);
+		ASSERT_EQ(sample.index(), positions[i]);
+		i++;
+	}//: for
+	ASSERT_EQ(i, positions.size());
+
+	// Materialize the view.
+	mic::types::Batch<int, unsigned int> copy = view.materialize();
+	ASSERT_EQ(copy.size(), positions.size());
+	for (size_t j = 0; j < positions.size(); j++)
+		ASSERT_EQ(copy.data(j).get(), batch.data(positions[j]).get());
+
+	ASSERT_THROW(view.getSample(3), std::out_of_range);
+}
+
+
+/*!
+ * Tests whether random views reuse the buffer and contain valid samples.
+ */
+TEST(Batch, RandomBatchView) {
+	mic::types::Batch<int, unsigned int> batch = createBatch(10, 5);
+
+	auto view = batch.getRandomBatchView();
+	const size_t* buffer = batch.view_positions.data();
+	for (size_t r = 0; r < 10; r++) {
+		view = batch.getRandomBatchView();
+		ASSERT_EQ(view.size(), 5);
+		for (size_t i = 0; i < view.size(); i++) {
+			ASSERT_LT(view.indices(i), 10);
+			ASSERT_EQ(*view.data(i), view.indices(i)*10);
+		}//: for
+	}//: for
+	ASSERT_EQ(batch.view_positions.data(), buffer);
+}
+
+
+/*!
+ * Tests whether views of an empty batch or batches exceeding the number of samples are rejected.
+ */
+TEST(Batch, InvalidBatchViews) {
+	mic::types::Batch<int, unsigned int> empty(5);
+	ASSERT_THROW(empty.getRandomBatchView(), std::logic_error);
+	ASSERT_THROW(empty.getNextBatchView(), std::logic_error);
+
+	mic::types::Batch<int, unsigned int> batch = createBatch(3, 4);
+	ASSERT_THROW(batch.getNextBatchView(), std::logic_error);
+	batch.setBatchSize(3);
+	ASSERT_EQ(batch.getNextBatchView().size(), 3);
+}
+
+
+/*!
+ * Tests packing of matrix samples into a preallocated matrix (one sample per column) and labels into 1-of-k matrix.
+ */
+TEST(Batch, PackMatrixSamples) {
+	const size_t N = 2;
+	const size_t M = 3;
+	mic::types::Batch<mic::types::Matrix<float>, unsigned int> batch(4);
+	for (size_t s = 0; s < 10; s++) {
+		mic::types::MatrixPtr<float> mat = std::make_shared<mic::types::Matrix<float> >(N, M);
+		mat->setValue(s);
+		(*mat)(1,2) = -1.0f * s;
+		batch.add(mat, std::make_shared<unsigned int>(s%3));
+	}//: for
+
+	mic::types::Matrix<float> packed;
+	mic::types::Matrix<float> one_hot;
+	batch.setNextSampleIndex(4);
+	auto view = batch.getNextBatchView();
+	mic::types::packSamples(view, packed);
+	mic::types::packOneHot(view, 3, one_hot);
+	float* packed_ptr = packed.data();
+
+	// Next call must reuse the same memory.
+	mic::types::packSamples(view, packed);
+	ASSERT_EQ(packed.data(), packed_ptr);
+
+	ASSERT_EQ(packed.rows(), N*M);
+	ASSERT_EQ(packed.cols(), 4);
+	for (size_t i = 0; i < 4; i++) {
+		ASSERT_EQ(packed(0, i), 4 + i);
+		ASSERT_EQ(packed(N*M-1, i), -1.0f * (4 + i));
+		for (size_t c = 0; c < 3; c++)
+			ASSERT_EQ(one_hot(c, i), ((4 + i)%3 == c) ? 1 : 0);
+	}//: for
+
+	// Empty source - the result of the previous call must not be left.
+	mic::types::Batch<mic::types::Matrix<float>, unsigned int> empty(4);
+	mic::types::packSamples(empty, packed);
+	ASSERT_EQ(packed.cols(), 0);
+	ASSERT_EQ(packed.size(), 0);
+}
+
+
+/*!
+ * Tests packing of tensor samples into a preallocated tensor (batch as the last dimension).
+ */
+TEST(Batch, PackTensorSamples) {
+	mic::types::Batch<mic::types::Tensor<float>, unsigned int> batch(3);
+	for (size_t s = 0; s < 3; s++) {
+		std::shared_ptr<mic::types::Tensor<float> > t = std::make_shared<mic::types::Tensor<float> >(mic::types::Tensor<float>({2, 2, 3}));
+		t->setValue(s);
+		batch.add(t, std::make_shared<unsigned int>(s));
+	}//: for
+
+	mic::types::Tensor<float> packed;
+	auto view = batch.getNextBatchView();
+	mic::types::packSamples(view, packed);
+
+	ASSERT_EQ(packed.dims().size(), 4);
+	ASSERT_EQ(packed.dim(3), 3);
+	for (size_t s = 0; s < 3; s++)
+		for (size_t i = 0; i < 12; i++)
+			ASSERT_EQ(packed(s*12 + i), s);
+
+	std::vector<unsigned int> labels;
+	mic::types::packLabels(view, labels);
+	ASSERT_EQ(labels.size(), 3);
+	ASSERT_EQ(labels[2], 2);
+
+	// Empty source - the result of the previous call must not be left.
+	mic::types::Batch<mic::types::Tensor<float>, unsigned int> empty(3);
+	mic::types::packSamples(empty, packed);
+	ASSERT_EQ(packed.size(), 0);
+}
+
+
+/*!
+ * Tests the histogram of labels and its incremental update.
+ */
+TEST(Batch, ClassHistogram) {
+	mic::types::Batch<int, unsigned int> batch = createBatch(25, 1);
+
+	batch.countClasses();
+	ASSERT_EQ(batch.classes(), 10);
+	auto histogram = batch.classHistogram();
+	ASSERT_EQ(histogram[0], 3);
+	ASSERT_EQ(histogram[9], 2);
+
+	// Add samples of a new class - only they are indexed.
+	batch.add(std::make_shared<int>(0), std::make_shared<unsigned int>(42));
+	batch.add(std::make_shared<int>(0), std::make_shared<unsigned int>(42));
+	batch.countClasses();
+	ASSERT_EQ(batch.classes(), 11);
+	ASSERT_EQ(batch.classIndex().at(42).size(), 2);
+	ASSERT_EQ(batch.classIndex().at(42)[1], 26);
+}
+
+
+/*!
+ * Tests class-balanced and stratified sampling.
+ */
+TEST(Batch, ClassSampling) {
+	// Imbalanced dataset: 90 samples of class 0, 10 samples of class 1.
+	mic::types::Batch<int, unsigned int> batch(10);
+	for (size_t i = 0; i < 100; i++)
+		batch.add(std::make_shared<int>(i), std::make_shared<unsigned int>(i < 90 ? 0 : 1));
+
+	// Stratified - exactly 9 samples of class 0 and 1 of class 1.
+	auto view = batch.getStratifiedBatchView();
+	ASSERT_EQ(view.size(), 10);
+	size_t ones = 0;
+	for (size_t i = 0; i < view.size(); i++)
+		ones += *view.labels(i);
+	ASSERT_EQ(ones, 1);
+
+	// Balanced - classes chosen uniformly.
+	batch.setBatchSize(1000);
+	view = batch.getBalancedBatchView();
+	ones = 0;
+	for (size_t i = 0; i < view.size(); i++)
+		ones += *view.labels(i);
+	ASSERT_GT(ones, 400);
+	ASSERT_LT(ones, 600);
+
+	// Empty batch - nothing to sample from.
+	mic::types::Batch<int, unsigned int> empty(10);
+	ASSERT_THROW(empty.getStratifiedBatchView(), std::logic_error);
+	ASSERT_THROW(empty.getBalancedBatchView(), std::logic_error);
+}
+
+
+/*!
+ * Tests whether an epoch visits every sample exactly once and the last batch is handled according to the policy.
+ */
+TEST(Batch, EpochIteration) {
+	mic::types::Batch<int, unsigned int> batch = createBatch(23, 5);
+	batch.setEpochSeed(7);
+
+	// Drop - 4 batches, 3 samples skipped.
+	std::vector<size_t> visits(23, 0);
+	ASSERT_EQ(batch.epochBatches(), 4);
+	for (size_t b = 0; b < 4; b++) {
+		auto view = batch.getNextEpochBatchView();
+		ASSERT_EQ(view.size(), 5);
+		for (size_t i = 0; i < view.size(); i++)
+			visits[view.position(i)]++;
+	}//: for
+	ASSERT_TRUE(batch.isEpochFinished());
+	size_t visited = 0;
+	for (size_t v : visits) {
+		ASSERT_LE(v, 1);
+		visited += v;
+	}//: for
+	ASSERT_EQ(visited, 20);
+
+	// Next epoch has a different permutation.
+	batch.getNextEpochBatchView();
+	ASSERT_EQ(batch.getEpoch(), 1);
+
+	// Partial - 5 batches, the last one with 3 samples.
+	batch.setLastBatchPolicy(mic::types::LastBatchPolicy::Partial);
+	batch.setEpochSeed(7);
+	std::fill(visits.begin(), visits.end(), 0);
+	for (size_t b = 0; b < 5; b++) {
+		auto view = batch.getNextEpochBatchView();
+		ASSERT_EQ(view.size(), (b < 4) ? 5 : 3);
+		for (size_t i = 0; i < view.size(); i++)
+			visits[view.position(i)]++;
+	}//: for
+	for (size_t v : visits)
+		ASSERT_EQ(v, 1);
+
+	// Pad - the last batch is full.
+	batch.setLastBatchPolicy(mic::types::LastBatchPolicy::Pad);
+	batch.setEpochSeed(7);
+	for (size_t b = 0; b < 4; b++)
+		batch.getNextEpochBatchView();
+	ASSERT_EQ(batch.getNextEpochBatchView().size(), 5);
+	ASSERT_TRUE(batch.isEpochFinished());
+}
+
+
+/*!
+ * Tests whether the epoch iteration can be resumed from a cursor.
+ */
+TEST(Batch, EpochResume) {
+	mic::types::Batch<int, unsigned int> batch = createBatch(50, 8);
+	batch.setEpochSeed(1234);
+
+	// Go to the middle of the second epoch.
+	for (size_t b = 0; b < 9; b++)
+		batch.getNextEpochBatchView();
+	mic::types::EpochCursor cursor = batch.getEpochCursor();
+	auto expected = batch.getNextEpochBatch();
+
+	// Resume in another batch.
+	mic::types::Batch<int, unsigned int> resumed = createBatch(50, 8);
+	resumed.setEpochCursor(cursor);
+	auto view = resumed.getNextEpochBatchView();
+	ASSERT_EQ(resumed.getEpoch(), 1);
+	ASSERT_EQ(view.size(), expected.size());
+	for (size_t i = 0; i < view.size(); i++)
+		ASSERT_EQ(*view.data(i), *expected.data()[i]);
+
+	// Assignment carries the iterator state as well.
+	mic::types::Batch<int, unsigned int> assigned = createBatch(50, 8);
+	assigned.getNextEpochBatchView();
+	assigned = batch;
+	ASSERT_TRUE(assigned.epoch_permutation.empty());
+	ASSERT_EQ(assigned.getEpochCursor().seed, batch.getEpochCursor().seed);
+	ASSERT_EQ(assigned.getEpochCursor().epoch, batch.getEpochCursor().epoch);
+	ASSERT_EQ(assigned.getEpochCursor().position, batch.getEpochCursor().position);
+	auto from_assigned = assigned.getNextEpochBatch();
+	auto from_original = batch.getNextEpochBatch();
+	ASSERT_EQ(from_assigned.size(), from_original.size());
+	for (size_t i = 0; i < from_assigned.size(); i++)
+		ASSERT_EQ(*from_assigned.data()[i], *from_original.data()[i]);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
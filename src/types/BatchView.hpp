@@ -0,0 +1,212 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BatchView.hpp
+ * \brief Contains declaration (and definition) of a non-owning view over samples of a batch.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_BATCHVIEW_HPP_
+#define SRC_TYPES_BATCHVIEW_HPP_
+
+#include <types/Sample.hpp>
+
+#include <vector>
+#include <stdexcept>
+
+namespace mic {
+namespace types {
+
+// Forward declaration of a class Batch.
+template<typename DataType, typename LabelType>
+class Batch;
+
+/*!
+ * \brief Template class representing a view of a subset of samples of a (parent) batch.
+ * The view does not own nor copy anything - it is either a span of consecutive positions [begin, begin+size) in the parent batch,
+ * or a list of positions (e.g. a random permutation) stored outside of the view.
+ * Thus creation of a view involves no memory allocation, no random generator construction and no reference counting.
+ * Note: the view is valid as long as the parent batch (and, in the case of list of positions, the list itself) is not modified.
+ * @tparam DataType Template parameter defining the sample data type.
+ * @tparam LabelType Template parameters defining the sample label label.
+ * \author tkornuta
+ */
+template<typename DataType, typename LabelType>
+class BatchView {
+public:
+	/*!
+	 * \brief Forward iterator returning consecutive samples of the view.
+	 */
+	class iterator {
+	public:
+		/*!
+		 * Constructor.
+		 * @param view_ The iterated view.
+		 * @param position_ Position in the view.
+		 */
+		iterator(const BatchView<DataType, LabelType>* view_, size_t position_) : view(view_), position(position_) { }
+
+		/// Returns the sample at the current position.
+		mic::types::Sample<DataType, LabelType> operator*() const {
+			return view->getSample(position);
+		}
+
+		/// Moves to the next sample.
+		iterator& operator++() {
+			++position;
+			return *this;
+		}
+
+		/// Compares positions of two iterators.
+		bool operator!=(const iterator& other_) const {
+			return (position != other_.position) || (view != other_.view);
+		}
+
+		/// Compares positions of two iterators.
+		bool operator==(const iterator& other_) const {
+			return !(*this != other_);
+		}
+
+	private:
+		/// The iterated view.
+		const BatchView<DataType, LabelType>* view;
+
+		/// Position in the view.
+		size_t position;
+	};
+
+	/*!
+	 * Constructor of an empty view.
+	 */
+	BatchView() : parent(nullptr), positions(nullptr), begin_position(0), view_size(0) { }
+
+	/*!
+	 * Constructor of a view being a span of consecutive samples of the parent batch.
+	 * @param parent_ Parent batch.
+	 * @param begin_ Position of the first sample in the parent batch.
+	 * @param size_ Number of samples.
+	 */
+	BatchView(mic::types::Batch<DataType, LabelType>* parent_, size_t begin_, size_t size_) :
+		parent(parent_), positions(nullptr), begin_position(begin_), view_size(size_) { }
+
+	/*!
+	 * Constructor of a view being a list of positions (e.g. a permutation) in the parent batch.
+	 * The list is not copied - it must outlive the view.
+	 * @param parent_ Parent batch.
+	 * @param positions_ Pointer to the table of positions in the parent batch.
+	 * @param size_ Number of samples.
+	 */
+	BatchView(mic::types::Batch<DataType, LabelType>* parent_, const size_t* positions_, size_t size_) :
+		parent(parent_), positions(positions_), begin_position(0), view_size(size_) { }
+
+	/*!
+	 * Returns the size of the view.
+	 * @return Number of samples.
+	 */
+	size_t size() const {
+		return view_size;
+	}
+
+	/*!
+	 * Returns position of a given sample in the parent batch.
+	 * @param index_ Index of the sample in the view.
+	 * @return Position in the parent batch.
+	 */
+	inline size_t position(size_t index_) const {
+		return (positions != nullptr) ? positions[index_] : begin_position + index_;
+	}
+
+	/*!
+	 * Returns data of a given sample - a reference to the pointer stored in the parent batch, so there is no reference counting.
+	 * @param index_ Index of the sample in the view.
+	 * @return Data.
+	 */
+	inline const std::shared_ptr<DataType>& data(size_t index_) const {
+		return parent->data()[position(index_)];
+	}
+
+	/*!
+	 * Returns label of a given sample - a reference to the pointer stored in the parent batch, so there is no reference counting.
+	 * @param index_ Index of the sample in the view.
+	 * @return Sample label.
+	 */
+	inline const std::shared_ptr<LabelType>& labels(size_t index_) const {
+		return parent->labels()[position(index_)];
+	}
+
+	/*!
+	 * Returns sample number (sample "position" in original dataset).
+	 * @param index_ Index of the sample in the view.
+	 * @return Sample number.
+	 */
+	inline size_t indices(size_t index_) const {
+		return parent->indices()[position(index_)];
+	}
+
+	/*!
+	 * Returns a given sample. If index is out of view range throws an "std::out_of_range" exception.
+	 * @param index_ Index of the sample in the view.
+	 * @return Sample containing shared pointer to sample data, its label and sample number.
+	 */
+	mic::types::Sample<DataType, LabelType> getSample(size_t index_) const {
+		// Check index.
+		if (index_ >= view_size)
+			throw std::out_of_range("Sample index out of view range!");
+		return parent->getSampleDirect(position(index_));
+	}
+
+	/*!
+	 * Copies the samples into a new, standalone batch.
+	 * @return Batch containing the samples of the view.
+	 */
+	mic::types::Batch<DataType, LabelType> materialize() const {
+		mic::types::Batch<DataType, LabelType> batch(view_size);
+		batch.reserve(view_size);
+		for (size_t i = 0; i < view_size; i++)
+			batch.add(data(i), labels(i), indices(i));
+		return batch;
+	}
+
+	/// Returns iterator pointing to the first sample.
+	iterator begin() const {
+		return iterator(this, 0);
+	}
+
+	/// Returns iterator pointing after the last sample.
+	iterator end() const {
+		return iterator(this, view_size);
+	}
+
+private:
+	/// The parent batch.
+	mic::types::Batch<DataType, LabelType>* parent;
+
+	/// Pointer to the (external) table of positions in the parent batch, nullptr for span views.
+	const size_t* positions;
+
+	/// Position of the first sample (span views only).
+	size_t begin_position;
+
+	/// Number of samples.
+	size_t view_size;
+};
+
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_BATCHVIEW_HPP_ */
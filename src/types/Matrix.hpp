@@ -26,6 +26,15 @@
 #include <Eigen/Dense>
 #include <random>
 #include <memory> // std::shared_ptr
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+#include <types/Parallel.hpp>
+#include <types/RandomFill.hpp>
+#include <types/Reductions.hpp>
 
 #include <boost/serialization/serialization.hpp>
 // include this header to serialize vectors
@@ -166,6 +175,92 @@ public:
 	}
 
 
+	/*!
+	 * Computes the (general) matrix product with optional transpositions and accumulation: c = alpha * op(a) * op(b) + beta * c, where op(x) is x or x^T.
+	 * The result is written directly into the destination - no temporary matrices are created (also for transposed operands).
+	 * Uses OpenBLAS (sgemm/dgemm) for floats and doubles if found by CMAKE, Eigen products otherwise.
+	 * Note: the destination must not alias the operands.
+	 * @param a_ Left operand.
+	 * @param b_ Right operand.
+	 * @param c_ Destination - resized if beta_ is equal to zero, otherwise its size must match the product.
+	 * @param transpose_a_ Flag indicating whether the left operand is transposed (DEFAULT=false).
+	 * @param transpose_b_ Flag indicating whether the right operand is transposed (DEFAULT=false).
+	 * @param alpha_ Scale of the product (DEFAULT=1).
+	 * @param beta_ Scale of the previous content of the destination (DEFAULT=0).
+	 */
+	static void gemm(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a_, const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& b_, Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& c_,
+			bool transpose_a_ = false, bool transpose_b_ = false, T alpha_ = 1, T beta_ = 0) {
+		const size_t m = transpose_a_ ? a_.cols() : a_.rows();
+		const size_t k = transpose_a_ ? a_.rows() : a_.cols();
+		const size_t n = transpose_b_ ? b_.rows() : b_.cols();
+		if (k != (size_t)(transpose_b_ ? b_.cols() : b_.rows()))
+			throw std::invalid_argument("gemm: inner dimensions mismatch!");
+		if (beta_ == 0)
+			c_.resize(m, n);
+		else if ((m != (size_t)c_.rows()) || (n != (size_t)c_.cols()))
+			throw std::invalid_argument("gemm: destination dimensions mismatch!");
+
+		gemmKernel(a_.data(), b_.data(), c_.data(), m, n, k, transpose_a_, transpose_b_, alpha_, beta_);
+	}
+
+	/*!
+	 * Computes the matrix-vector product with optional transposition and accumulation: y = alpha * op(a) * x + beta * y, where op(a) is a or a^T.
+	 * Uses OpenBLAS (sgemv/dgemv) for floats and doubles if found by CMAKE, Eigen products otherwise.
+	 * @param a_ Matrix.
+	 * @param x_ Vector.
+	 * @param y_ Destination - resized if beta_ is equal to zero, otherwise its size must match the product.
+	 * @param transpose_ Flag indicating whether the matrix is transposed (DEFAULT=false).
+	 * @param alpha_ Scale of the product (DEFAULT=1).
+	 * @param beta_ Scale of the previous content of the destination (DEFAULT=0).
+	 */
+	static void gemv(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a_, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x_, Eigen::Matrix<T, Eigen::Dynamic, 1>& y_,
+			bool transpose_ = false, T alpha_ = 1, T beta_ = 0) {
+		const size_t m = transpose_ ? a_.cols() : a_.rows();
+		if ((size_t)x_.rows() != (size_t)(transpose_ ? a_.rows() : a_.cols()))
+			throw std::invalid_argument("gemv: dimensions mismatch!");
+		if (beta_ == 0)
+			y_.resize(m);
+		else if (m != (size_t)y_.rows())
+			throw std::invalid_argument("gemv: destination dimensions mismatch!");
+
+		gemvKernel(a_.data(), a_.rows(), a_.cols(), x_.data(), y_.data(), transpose_, alpha_, beta_);
+	}
+
+	/*!
+	 * Computes products of a batch of matrices stored as 3D tensors - c(:,:,i) = alpha * op(a(:,:,i)) * op(b(:,:,i)) + beta * c(:,:,i).
+	 * Every 2D slice of a tensor is a column-major matrix (0th dimension being the fastest changing one), hence the slices are multiplied in place, without copying.
+	 * The products are computed in parallel over the batch, unless the kernel is already multithreaded (OpenBLAS) - then the slices are multiplied one by one, so the threads of the library do not oversubscribe the cores.
+	 * @param a_ Left operands - tensor [rows x cols x batch].
+	 * @param b_ Right operands - tensor [rows x cols x batch].
+	 * @param c_ Destinations - resized if beta_ is equal to zero, otherwise its size must match the products.
+	 * @param transpose_a_ Flag indicating whether the left operands are transposed (DEFAULT=false).
+	 * @param transpose_b_ Flag indicating whether the right operands are transposed (DEFAULT=false).
+	 * @param alpha_ Scale of the products (DEFAULT=1).
+	 * @param beta_ Scale of the previous content of the destinations (DEFAULT=0).
+	 */
+	static void batchedGemm(const mic::types::Tensor<T>& a_, const mic::types::Tensor<T>& b_, mic::types::Tensor<T>& c_,
+			bool transpose_a_ = false, bool transpose_b_ = false, T alpha_ = 1, T beta_ = 0) {
+		if ((a_.dims().size() != 3) || (b_.dims().size() != 3) || (a_.dim(2) != b_.dim(2)))
+			throw std::invalid_argument("batchedGemm: operands must be 3D tensors with equal batch sizes!");
+		const size_t batch = a_.dim(2);
+		const size_t m = transpose_a_ ? a_.dim(1) : a_.dim(0);
+		const size_t k = transpose_a_ ? a_.dim(0) : a_.dim(1);
+		const size_t n = transpose_b_ ? b_.dim(0) : b_.dim(1);
+		if (k != (transpose_b_ ? b_.dim(1) : b_.dim(0)))
+			throw std::invalid_argument("batchedGemm: inner dimensions mismatch!");
+		if (beta_ == 0)
+			c_.resize({m, n, batch});
+		else if (c_.dims() != std::vector<size_t>({m, n, batch}))
+			throw std::invalid_argument("batchedGemm: destination dimensions mismatch!");
+
+		const T* a = a_.data();
+		const T* b = b_.data();
+		T* c = c_.data();
+#pragma omp parallel for if(!threadedGemmKernel() && mic::types::useParallel(batch * m * n * k))
+		for (size_t i = 0; i < batch; i++)
+			gemmKernel(a + i * m * k, b + i * k * n, c + i * m * n, m, n, k, transpose_a_, transpose_b_, alpha_, beta_);
+	}
+
 	/*!
 	 * Sets values of all element to the value given as parameter.
 	 * @param value_ The value to be set.
@@ -174,7 +269,7 @@ public:
 		// Get access to data.
 		T* data_ptr = this->data();
 
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t i = 0; i < (size_t) (this->rows() * this->cols()); i++)
 			data_ptr[i] = value_;
 	}
@@ -186,7 +281,7 @@ public:
 		// Get access to data.
 		T* data_ptr = this->data();
 
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t i = 0; i < (size_t)this->size(); i++)
 			data_ptr[i] = i;
 	}
@@ -197,19 +292,7 @@ public:
 	 * @param stddev Variance
 	 */
 	void randn(T mean = 0, T stddev = 1) {
-
-		// Initialize random number generator with normal distribution.
-		std::random_device rd;
-		std::mt19937 mt(rd());
-		std::normal_distribution<T> dist(mean, stddev);
-
-		// Get access to data.
-		T* data_ptr = this->data();
-
-#pragma omp parallel for
-		for (size_t i = 0; i < (size_t) (this->rows() * this->cols()); i++) {
-			data_ptr[i] = (T)dist(mt);
-		}
+		mic::types::fillNormal(this->data(), (size_t)this->size(), mean, stddev);
 	}
 
 	/*!
@@ -219,192 +302,378 @@ public:
 	 * @return Random real value.
 	 */
 	void rand(T min = 0, T max = 1) {
-
-		// Initialize random number generator with normal distribution.
-		std::random_device rd;
-		std::mt19937 mt(rd());
-		std::uniform_real_distribution<T> dist(min, max);
-
-		// Get access to data.
-		T* data_ptr = this->data();
-
-#pragma omp parallel for
-		for (size_t i = 0; i < (size_t) (this->rows() * this->cols()); i++) {
-			data_ptr[i] = (T)dist(rd);
-		}
+		mic::types::fillUniform(this->data(), (size_t)this->size(), min, max);
 	}
 
 
 	/*!
 	 * Applies elementwise function to all matrix elements.
+	 * The function is a template parameter, so lambdas and functors (e.g. Eigen unary ops) are inlined and the loop can be vectorized.
+	 * @tparam Func Type of the function - any callable T(T).
 	 * @param func Function to be applied.
 	 */
-	void elementwiseFunction(T (*func)(T)) {
+	template<typename Func>
+	void elementwiseFunction(Func func) {
 
 		// Get access to data.
 		T* data_ptr = this->data();
 
 		// Apply function to all elements.
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t i = 0; i < (size_t) (this->rows() * this->cols()); i++) {
-			data_ptr[i] = (*func)(data_ptr[i]);
+			data_ptr[i] = func(data_ptr[i]);
 		} //: for i
 	}
 
+	/*!
+	 * Applies elementwise function to all matrix elements - overload resolving overloaded function names (e.g. std::exp).
+	 * @param func Function to be applied.
+	 */
+	void elementwiseFunction(T (*func)(T)) {
+		elementwiseFunction<T (*)(T)>(func);
+	}
+
 	/*!
 	 * Applies elementwise function to all matrix elements passing scalar as function argument.
+	 * @tparam Func Type of the function - any callable T(T, T).
 	 * @param func Function to be applied.
 	 * @param scalar_ Scalar passed to function as argument.
 	 */
-	void elementwiseFunctionScalar(T (*func)(T, T), T scalar_) {
+	template<typename Func>
+	void elementwiseFunctionScalar(Func func, T scalar_) {
 
 		// Get access to data.
 		T* data_ptr = this->data();
 
 		// Apply function to all elements.
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t i = 0; i < (size_t) (this->rows() * this->cols()); i++) {
-			data_ptr[i] = (*func)(data_ptr[i], scalar_);
+			data_ptr[i] = func(data_ptr[i], scalar_);
 		} //: for i
 	}
 
+	/*!
+	 * Applies elementwise function to all matrix elements passing scalar as function argument - overload resolving overloaded function names.
+	 * @param func Function to be applied.
+	 * @param scalar_ Scalar passed to function as argument.
+	 */
+	void elementwiseFunctionScalar(T (*func)(T, T), T scalar_) {
+		elementwiseFunctionScalar<T (*)(T, T)>(func, scalar_);
+	}
+
 	/*!
 	 * Applies elementwise function to all matrix elements and uses additional Matrix mat_ data as function parameter.
+	 * @tparam Func Type of the function - any callable T(T, T).
 	 * @param func Function to be applied.
 	 * @param mat_ Matrix passed to function as argument.
 	 */
-	void elementwiseFunctionMatrix(T (*func)(T, T), Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> & mat_) {
+	template<typename Func>
+	void elementwiseFunctionMatrix(Func func, const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> & mat_) {
 
 		// Check dimensions.
 		if ((this->rows() != mat_.rows()) || (this->cols() != mat_.cols()))
-			printf("elementwiseFunctionMatrix: dimensions mismatch!\n");
+			throw std::invalid_argument("elementwiseFunctionMatrix: dimensions mismatch!");
 
 		// Get access to data.
 		T* data_ptr = this->data();
-		T* m_data_ptr = mat_.data();
+		const T* m_data_ptr = mat_.data();
 
 		// Apply function to all elements.
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t i = 0; i < (size_t) (this->rows() * this->cols()); i++) {
-			data_ptr[i] = (*func)(data_ptr[i], m_data_ptr[i]);
+			data_ptr[i] = func(data_ptr[i], m_data_ptr[i]);
 		}//: for i
 
 	}
 
 	/*!
-	 * Applies function to all matrix elements and uses additional vector data as function parameter - columnwise.
+	 * Applies elementwise function to all matrix elements and uses additional Matrix mat_ data as function parameter - overload resolving overloaded function names.
+	 * @param func Function to be applied.
+	 * @param mat_ Matrix passed to function as argument.
+	 */
+	void elementwiseFunctionMatrix(T (*func)(T, T), const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> & mat_) {
+		elementwiseFunctionMatrix<T (*)(T, T)>(func, mat_);
+	}
+
+	/*!
+	 * Applies function to all matrix elements and uses additional vector data as function parameter - columnwise, i.e. element (y,x) is combined with v_(y).
+	 * @tparam Func Type of the function - any callable T(T, T).
 	 * @param func Used function
-	 * @param v_ Vector passed to function
+	 * @param v_ Vector passed to function (of size equal to the number of rows).
 	 */
-	void matrixColumnVectorFunction(T (*func)(T, T),
-			Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+	template<typename Func>
+	void matrixColumnVectorFunction(Func func, const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
 
-		if (this->rows() != v_.cols())
-			printf("matrixColumnVectorFunction: dimensions mismatch\n");
+		checkColumnVector(v_, "matrixColumnVectorFunction");
 
 		// Get access to data.
-		//float* data_ptr = data();
-		//int rows = this->rows();
-		//int cols = this->cols();
-		//float* vector_data_ptr = v_.data();
+		T* data_ptr = this->data();
+		const T* vector_data_ptr = v_.data();
+		const size_t rows = this->rows();
 
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t x = 0; x < (size_t)this->cols(); x++) {
-			for (size_t y = 0; y < (size_t)this->rows(); y++) {
-				//data_ptr[x + y*cols] = (*func)(data_ptr[x + y*cols], vector_data_ptr[x]);
-				(*this)(y, x) = (*func)((*this)(y, x), v_(y));
-			}//: for y
+			// Columns are contiguous.
+			T* column_ptr = data_ptr + x * rows;
+			for (size_t y = 0; y < rows; y++)
+				column_ptr[y] = func(column_ptr[y], vector_data_ptr[y]);
 		}//: for x
 	}
 
 	/*!
-	 * Applies function to all matrix elements and uses additional vector data as function parameter - rowwise.
+	 * Applies function to all matrix elements and uses additional vector data as function parameter - columnwise - overload resolving overloaded function names.
 	 * @param func Used function
 	 * @param v_ Vector passed to function
 	 */
-	void matrixRowVectorFunction(T (*func)(T, T), Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+	void matrixColumnVectorFunction(T (*func)(T, T), const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		matrixColumnVectorFunction<T (*)(T, T)>(func, v_);
+	}
 
-		if (this->cols() != v_.cols())
-			printf("matrixRowVectorFunction: dimensions mismatch\n");
+	/*!
+	 * Applies function to all matrix elements and uses additional vector data as function parameter - rowwise, i.e. element (y,x) is combined with v_(x).
+	 * @tparam Func Type of the function - any callable T(T, T).
+	 * @param func Used function
+	 * @param v_ Vector passed to function (of size equal to the number of columns).
+	 */
+	template<typename Func>
+	void matrixRowVectorFunction(Func func, const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+
+		checkRowVector(v_, "matrixRowVectorFunction");
 
 		// Get access to data.
-		/*float* data_ptr = data();
-		 int rows = this->rows();
-		 int cols = this->cols();
-		 float* vector_data_ptr = v_.data();*/
+		T* data_ptr = this->data();
+		const T* vector_data_ptr = v_.data();
+		const size_t rows = this->rows();
 
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
 		for (size_t x = 0; x < (size_t)this->cols(); x++) {
-			for (size_t y = 0; y < (size_t)this->rows(); y++) {
-				//h(y,x) += c(x);
-				//(*this)(y,x) += v_(x);
-				(*this)(y, x) = (*func)((*this)(y, x), v_(x));
-				//data_ptr[x + y*cols] = (*func)(data_ptr[x + y*cols], vector_data_ptr[y]);
-			}//: for y
+			// Columns are contiguous - and combined with the same vector element.
+			T* column_ptr = data_ptr + x * rows;
+			const T value = vector_data_ptr[x];
+			for (size_t y = 0; y < rows; y++)
+				column_ptr[y] = func(column_ptr[y], value);
 		}//: for x
 	}
 
+	/*!
+	 * Applies function to all matrix elements and uses additional vector data as function parameter - rowwise - overload resolving overloaded function names.
+	 * @param func Used function
+	 * @param v_ Vector passed to function
+	 */
+	void matrixRowVectorFunction(T (*func)(T, T), const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		matrixRowVectorFunction<T (*)(T, T)>(func, v_);
+	}
+
 
 	/*!
 	 * Sets the consecutive columns to be equal to given vector.
-	 * @param in Input vector, that will be "cloned".
+	 * @param in Input vector, that will be "cloned" (of size equal to the number of rows).
 	 */
-	void repeatVector(Eigen::Matrix<T, Eigen::Dynamic, 1> &in) {
-#pragma omp parallel for
-		for (size_t x = 0; x < (size_t)this->cols(); x++) {
-			for (size_t y = 0; y < (size_t)this->rows(); y++) {
-
-				(*this)(y, x) = in(y);
-			}//: y
-		}//: x
+	void repeatVector(const Eigen::Matrix<T, Eigen::Dynamic, 1> &in) {
+		checkColumnVector(in, "repeatVector");
+		forEachColumn([&in](ColumnMap col_, size_t) { col_ = in; });
 	}
 
 	/*!
-	 * Returns a vector of indices indicating maximal elements in consecutive matrix columns (colwise).
-	 * @return Vector of indices.
+	 * Adds a column vector to every column (e.g. bias addition to a batch of outputs).
+	 * @param v_ Vector (of size equal to the number of rows).
 	 */
-	Eigen::Matrix<T, Eigen::Dynamic, 1> colwiseReturnMaxIndices() {
+	void colwiseAdd(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkColumnVector(v_, "colwiseAdd");
+		forEachColumn([&v_](ColumnMap col_, size_t) { col_ += v_; });
+	}
 
-		Eigen::Matrix<T, Eigen::Dynamic, 1> indices((*this).cols());
+	/*!
+	 * Subtracts a column vector from every column.
+	 * @param v_ Vector (of size equal to the number of rows).
+	 */
+	void colwiseSub(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkColumnVector(v_, "colwiseSub");
+		forEachColumn([&v_](ColumnMap col_, size_t) { col_ -= v_; });
+	}
 
-		for (size_t i = 0; i < (size_t)(*this).cols(); i++) {
+	/*!
+	 * Multiplies every column elementwise by a column vector.
+	 * @param v_ Vector (of size equal to the number of rows).
+	 */
+	void colwiseMul(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkColumnVector(v_, "colwiseMul");
+		forEachColumn([&v_](ColumnMap col_, size_t) { col_.array() *= v_.array(); });
+	}
 
-			T current_max_val;
-			T index;
+	/*!
+	 * Divides every column elementwise by a column vector.
+	 * @param v_ Vector (of size equal to the number of rows).
+	 */
+	void colwiseDiv(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkColumnVector(v_, "colwiseDiv");
+		forEachColumn([&v_](ColumnMap col_, size_t) { col_.array() /= v_.array(); });
+	}
 
-			for (size_t j = 0; j < (size_t)(*this).rows(); j++) {
+	/*!
+	 * Adds a row vector to every row - element (y,x) is increased by v_(x).
+	 * @param v_ Vector (of size equal to the number of columns).
+	 */
+	void rowwiseAdd(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkRowVector(v_, "rowwiseAdd");
+		forEachColumn([&v_](ColumnMap col_, size_t x_) { col_.array() += v_(x_); });
+	}
 
-				if (j == 0 || (*this)(j, i) > current_max_val) {
+	/*!
+	 * Subtracts a row vector from every row - element (y,x) is decreased by v_(x).
+	 * @param v_ Vector (of size equal to the number of columns).
+	 */
+	void rowwiseSub(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkRowVector(v_, "rowwiseSub");
+		forEachColumn([&v_](ColumnMap col_, size_t x_) { col_.array() -= v_(x_); });
+	}
 
-					index = j;
-					current_max_val = (*this)(j, i);
-				}
+	/*!
+	 * Multiplies every row elementwise by a row vector - element (y,x) is multiplied by v_(x).
+	 * @param v_ Vector (of size equal to the number of columns).
+	 */
+	void rowwiseMul(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkRowVector(v_, "rowwiseMul");
+		forEachColumn([&v_](ColumnMap col_, size_t x_) { col_ *= v_(x_); });
+	}
 
-				indices(i) = index;
+	/*!
+	 * Divides every row elementwise by a row vector - element (y,x) is divided by v_(x).
+	 * @param v_ Vector (of size equal to the number of columns).
+	 */
+	void rowwiseDiv(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_) {
+		checkRowVector(v_, "rowwiseDiv");
+		forEachColumn([&v_](ColumnMap col_, size_t x_) { col_ /= v_(x_); });
+	}
 
-			}
-		}
+	/*!
+	 * Finds maximal elements in consecutive matrix columns (colwise) and their positions - e.g. predicted classes of a batch of outputs.
+	 * Columns are processed in parallel; every column is a contiguous block of memory, scanned with a vectorized reduction.
+	 * @param indices_ Output vector of (row) indices of maximal elements.
+	 * @param values_ Output vector of maximal elements.
+	 */
+	void colwiseArgMax(Eigen::Matrix<size_t, Eigen::Dynamic, 1>& indices_, Eigen::Matrix<T, Eigen::Dynamic, 1>& values_) const {
+		const size_t rows = this->rows();
+		const size_t cols = this->cols();
+		assert(rows > 0);
+		indices_.resize(cols);
+		values_.resize(cols);
+
+		const T* data = this->data();
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
+		for (size_t x = 0; x < cols; x++)
+			indices_(x) = mic::types::blockArgMax(data + x * rows, rows, values_(x));
+	}
 
+	/*!
+	 * Returns a vector of (row) indices of maximal elements in consecutive matrix columns (colwise).
+	 * @return Vector of indices.
+	 */
+	Eigen::Matrix<size_t, Eigen::Dynamic, 1> colwiseArgMax() const {
+		Eigen::Matrix<size_t, Eigen::Dynamic, 1> indices;
+		Eigen::Matrix<T, Eigen::Dynamic, 1> values;
+		colwiseArgMax(indices, values);
 		return indices;
 	}
 
+	/*!
+	 * Finds k maximal elements in consecutive matrix columns (colwise) - e.g. top-k predictions of a batch of outputs. Columns are processed in parallel.
+	 * @param k_ Number of searched elements (k_ <= rows).
+	 * @param indices_ Output matrix [k x cols] of (row) indices, the x-th column containing indices of k maximal elements of x-th column in descending order.
+	 * @param values_ Output matrix [k x cols] of the corresponding elements.
+	 */
+	void colwiseTopK(size_t k_, Eigen::Matrix<size_t, Eigen::Dynamic, Eigen::Dynamic>& indices_, Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& values_) const {
+		const size_t rows = this->rows();
+		const size_t cols = this->cols();
+		assert((k_ > 0) && (k_ <= rows));
+		indices_.resize(k_, cols);
+		values_.resize(k_, cols);
+
+		const T* data = this->data();
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
+		for (size_t x = 0; x < cols; x++)
+			mic::types::blockTopK(data + x * rows, rows, k_, values_.data() + x * k_, indices_.data() + x * k_);
+	}
+
+	/*!
+	 * Returns a vector of indices indicating maximal elements in consecutive matrix columns (colwise).
+	 * Note: indices are returned as elements of type T - kept for compatibility, colwiseArgMax() returns integer indices.
+	 * @return Vector of indices.
+	 */
+	Eigen::Matrix<T, Eigen::Dynamic, 1> colwiseReturnMaxIndices() const {
+		return colwiseArgMax().template cast<T>();
+	}
+
 	/*!
 	 * Calculates the cross entropy as measure of how accurate given matrix (treated as prediction) fits to the desired (target) matrix.
+	 * Probabilities are clamped to the smallest positive value of T, so zero predictions do not result in infinity (or NaN for zero targets).
+	 * Columns are processed in parallel, their losses are summed pairwise, in double precision.
 	 * @param targets_ Desired results (targets) in the form of a matrix of answers.
-	 * @return
+	 * @return Cross entropy summed over all columns.
 	 */
-	T calculateCrossEntropy(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& targets_) {
-
-		T ce = 0.0;
-		Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> error(this->rows(), this->cols());
+	T calculateCrossEntropy(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& targets_) const {
+		checkSameSize(targets_, "calculateCrossEntropy");
+		const size_t rows = this->rows();
+		const size_t cols = this->cols();
+		const T* data = this->data();
+		const T* targets = targets_.data();
+		const T eps = std::numeric_limits<T>::min();
+
+		std::vector<double> losses(cols);
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
+		for (size_t x = 0; x < cols; x++) {
+			const T* p = data + x * rows;
+			const T* t = targets + x * rows;
+			T loss = 0;
+			for (size_t y = 0; y < rows; y++)
+				loss -= (t[y] != 0) ? t[y] * std::log(std::max(p[y], eps)) : 0;
+			losses[x] = loss;
+		}//: for
+
+		return (T)mic::types::pairwiseSum(losses.data(), cols, IdentityTransform());
+	}
 
-		//check what has happened and get information content for that event
-		error.array() = - (this->unaryExpr(std::ptr_fun(::logf)).array() * targets_.array());
+	/*!
+	 * Computes log-softmax of consecutive columns (treated as logits) - x_i - log(sum_j exp(x_j)), with the maximum subtracted before exponentiation, so the result is numerically stable.
+	 * @param out_ Output matrix (resized to the size of the matrix).
+	 */
+	void colwiseLogSoftmax(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& out_) const {
+		const size_t rows = this->rows();
+		const size_t cols = this->cols();
+		out_.resize(rows, cols);
+		const T* data = this->data();
+		T* out = out_.data();
+
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
+		for (size_t x = 0; x < cols; x++) {
+			const T* z = data + x * rows;
+			const T lse = columnLogSumExp(z, rows);
+			T* o = out + x * rows;
+			for (size_t y = 0; y < rows; y++)
+				o[y] = z[y] - lse;
+		}//: for
+	}
 
-		// Sum the errors.
-		ce = error.sum();
+	/*!
+	 * Calculates the cross entropy between softmax of consecutive columns (treated as logits) and targets, fused into a single kernel - without creating the softmax (or any other temporary) matrix.
+	 * Uses log-sum-exp with the maximum subtracted, so the loss is finite also for large logits: loss = sum_i t_i * (lse - x_i).
+	 * @param targets_ Desired results (targets), e.g. one-hot encoded classes.
+	 * @return Cross entropy summed over all columns.
+	 */
+	T softmaxCrossEntropy(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& targets_) const {
+		return softmaxCrossEntropyKernel(targets_, nullptr);
+	}
 
-		return ce;
+	/*!
+	 * Calculates the cross entropy between softmax of consecutive columns (treated as logits) and targets together with its gradient with respect to logits: softmax(x) * sum(t) - t (softmax(x) - t for one-hot targets).
+	 * Every column is read from memory once and processed while it stays in cache.
+	 * @param targets_ Desired results (targets), e.g. one-hot encoded classes.
+	 * @param gradient_ Output matrix of gradients (resized to the size of the matrix).
+	 * @return Cross entropy summed over all columns.
+	 */
+	T softmaxCrossEntropyGradient(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& targets_, Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& gradient_) const {
+		gradient_.resize(this->rows(), this->cols());
+		return softmaxCrossEntropyKernel(targets_, gradient_.data());
 	}
 
 	/****************** ARMADILLO COMPATIBILITY *********************************/
@@ -425,6 +694,182 @@ public:
     }
 
 private:
+	/*!
+	 * Matrix product kernel operating on column-major blocks of memory: c = alpha * op(a) * op(b) + beta * c. Specialized for floats and doubles (OpenBLAS).
+	 * @param a_ Left operand - [m x k] (or [k x m] if transposed).
+	 * @param b_ Right operand - [k x n] (or [n x k] if transposed).
+	 * @param c_ Destination - [m x n].
+	 * @param m_ Number of rows of the product.
+	 * @param n_ Number of columns of the product.
+	 * @param k_ Inner dimension.
+	 * @param transpose_a_ Flag indicating whether the left operand is transposed.
+	 * @param transpose_b_ Flag indicating whether the right operand is transposed.
+	 * @param alpha_ Scale of the product.
+	 * @param beta_ Scale of the previous content of the destination.
+	 */
+	static void gemmKernel(const T* a_, const T* b_, T* c_, size_t m_, size_t n_, size_t k_, bool transpose_a_, bool transpose_b_, T alpha_, T beta_) {
+		typedef Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > ConstMap;
+		ConstMap a(a_, transpose_a_ ? k_ : m_, transpose_a_ ? m_ : k_);
+		ConstMap b(b_, transpose_b_ ? n_ : k_, transpose_b_ ? k_ : n_);
+		Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > c(c_, m_, n_);
+
+		if (transpose_a_ && transpose_b_)
+			accumulateProduct(a.transpose(), b.transpose(), c, alpha_, beta_);
+		else if (transpose_a_)
+			accumulateProduct(a.transpose(), b, c, alpha_, beta_);
+		else if (transpose_b_)
+			accumulateProduct(a, b.transpose(), c, alpha_, beta_);
+		else
+			accumulateProduct(a, b, c, alpha_, beta_);
+	}
+
+	/*!
+	 * Returns true if the matrix product kernel runs its own threads (OpenBLAS), so it should not be called from a parallel region. Specialized for floats and doubles.
+	 */
+	static bool threadedGemmKernel() {
+		return false;
+	}
+
+	/*!
+	 * Matrix-vector product kernel operating on blocks of memory: y = alpha * op(a) * x + beta * y. Specialized for floats and doubles (OpenBLAS).
+	 * @param a_ Matrix - [rows x cols], column-major.
+	 * @param rows_ Number of rows of the matrix.
+	 * @param cols_ Number of columns of the matrix.
+	 * @param x_ Vector.
+	 * @param y_ Destination.
+	 * @param transpose_ Flag indicating whether the matrix is transposed.
+	 * @param alpha_ Scale of the product.
+	 * @param beta_ Scale of the previous content of the destination.
+	 */
+	static void gemvKernel(const T* a_, size_t rows_, size_t cols_, const T* x_, T* y_, bool transpose_, T alpha_, T beta_) {
+		Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > a(a_, rows_, cols_);
+		Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1> > x(x_, transpose_ ? rows_ : cols_);
+		Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > y(y_, transpose_ ? cols_ : rows_);
+
+		if (transpose_)
+			accumulateProduct(a.transpose(), x, y, alpha_, beta_);
+		else
+			accumulateProduct(a, x, y, alpha_, beta_);
+	}
+
+	/*!
+	 * Evaluates the product of two Eigen expressions into a destination: c = alpha * a * b + beta * c (noalias - without a temporary).
+	 * @param a_ Left operand.
+	 * @param b_ Right operand.
+	 * @param c_ Destination.
+	 * @param alpha_ Scale of the product.
+	 * @param beta_ Scale of the previous content of the destination.
+	 */
+	template<typename A, typename B, typename C>
+	static void accumulateProduct(const A& a_, const B& b_, C& c_, T alpha_, T beta_) {
+		if (beta_ == 0) {
+			c_.noalias() = alpha_ * a_ * b_;
+		} else {
+			if (beta_ != 1)
+				c_ *= beta_;
+			c_.noalias() += alpha_ * a_ * b_;
+		}//: else
+	}
+
+	/// Type of a (writable) map of a matrix column.
+	typedef Eigen::Map< Eigen::Matrix<T, Eigen::Dynamic, 1> > ColumnMap;
+
+	/*!
+	 * Applies an operation to all columns - in parallel. Every column is passed as a map, so the operation can use (vectorized) Eigen expressions.
+	 * @tparam Op Type of the operation - callable void(ColumnMap, size_t).
+	 * @param op_ Operation called with the column and its index.
+	 */
+	template<typename Op>
+	void forEachColumn(Op op_) {
+		T* data_ptr = this->data();
+		const size_t rows = this->rows();
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
+		for (size_t x = 0; x < (size_t)this->cols(); x++)
+			op_(ColumnMap(data_ptr + x * rows, rows), x);
+	}
+
+	/*!
+	 * Checks whether the size of a column vector is equal to the number of rows.
+	 * @param v_ Vector.
+	 * @param name_ Name of the calling method.
+	 */
+	void checkColumnVector(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_, const char* name_) const {
+		if (this->rows() != v_.rows())
+			throw std::invalid_argument(std::string(name_) + ": dimensions mismatch!");
+	}
+
+	/*!
+	 * Checks whether the size of a row vector is equal to the number of columns.
+	 * @param v_ Vector.
+	 * @param name_ Name of the calling method.
+	 */
+	void checkRowVector(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v_, const char* name_) const {
+		if (this->cols() != v_.rows())
+			throw std::invalid_argument(std::string(name_) + ": dimensions mismatch!");
+	}
+
+	/*!
+	 * Checks whether the size of a matrix is equal to the size of this matrix.
+	 * @param m_ Matrix.
+	 * @param name_ Name of the calling method.
+	 */
+	void checkSameSize(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& m_, const char* name_) const {
+		if ((this->rows() != m_.rows()) || (this->cols() != m_.cols()))
+			throw std::invalid_argument(std::string(name_) + ": dimensions mismatch!");
+	}
+
+	/*!
+	 * Computes log(sum_i exp(z_i)) of a column - the maximum is subtracted before exponentiation.
+	 * @param z_ Pointer to the column.
+	 * @param rows_ Number of elements.
+	 * @return Log-sum-exp.
+	 */
+	static T columnLogSumExp(const T* z_, size_t rows_) {
+		const T max = mic::types::blockMax(z_, rows_);
+		T sum = 0;
+#pragma omp simd reduction(+:sum)
+		for (size_t y = 0; y < rows_; y++)
+			sum += std::exp(z_[y] - max);
+		return max + std::log(sum);
+	}
+
+	/*!
+	 * Fused softmax cross entropy kernel - computes the loss and (optionally) the gradient column by column, in parallel.
+	 * @param targets_ Targets.
+	 * @param gradient_ Pointer to the gradient data (nullptr if not required).
+	 * @return Cross entropy summed over all columns.
+	 */
+	T softmaxCrossEntropyKernel(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& targets_, T* gradient_) const {
+		checkSameSize(targets_, "softmaxCrossEntropy");
+		const size_t rows = this->rows();
+		const size_t cols = this->cols();
+		const T* data = this->data();
+		const T* targets = targets_.data();
+
+		std::vector<double> losses(cols);
+#pragma omp parallel for if(mic::types::useParallel(this->size()))
+		for (size_t x = 0; x < cols; x++) {
+			const T* z = data + x * rows;
+			const T* t = targets + x * rows;
+			const T lse = columnLogSumExp(z, rows);
+
+			T loss = 0, mass = 0;
+#pragma omp simd reduction(+:loss,mass)
+			for (size_t y = 0; y < rows; y++) {
+				loss += t[y] * (lse - z[y]);
+				mass += t[y];
+			}//: for
+			losses[x] = loss;
+
+			if (gradient_ != nullptr) {
+				T* g = gradient_ + x * rows;
+				for (size_t y = 0; y < rows; y++)
+					g[y] = std::exp(z[y] - lse) * mass - t[y];
+			}//: if
+		}//: for
+
+		return (T)mic::types::pairwiseSum(losses.data(), cols, IdentityTransform());
+	}
 
 	// Friend class - required for using boost serialization.
     friend class boost::serialization::access;
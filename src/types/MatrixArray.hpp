@@ -274,6 +274,26 @@ public:
 		return matrices.size();
 	}
 
+	/*!
+	 * Computes products of corresponding matrices of arrays - c[i] = alpha * op(a[i]) * op(b[i]) + beta * c[i] (e.g. gradients of all layers in one call).
+	 * Every product is computed by Matrix::gemm (OpenBLAS for floats and doubles if found by CMAKE), so the matrices can differ in size.
+	 * @param a_ Array of left operands.
+	 * @param b_ Array of right operands.
+	 * @param c_ Array of destinations (of the same size as operand arrays).
+	 * @param transpose_a_ Flag indicating whether the left operands are transposed (DEFAULT=false).
+	 * @param transpose_b_ Flag indicating whether the right operands are transposed (DEFAULT=false).
+	 * @param alpha_ Scale of the products (DEFAULT=1).
+	 * @param beta_ Scale of the previous content of the destinations (DEFAULT=0).
+	 */
+	static void batchedGemm(MatrixArray& a_, MatrixArray& b_, MatrixArray& c_,
+			bool transpose_a_ = false, bool transpose_b_ = false, T alpha_ = 1, T beta_ = 0) {
+		if ((a_.size() != b_.size()) || (a_.size() != c_.size()))
+			throw std::range_error("MatrixArrays " + a_.array_name + ", " + b_.array_name + " and " + c_.array_name + " differ in size");
+
+		for (size_t i = 0; i < a_.size(); i++)
+			mic::types::Matrix<T>::gemm(*a_[i], *b_[i], *c_[i], transpose_a_, transpose_b_, alpha_, beta_);
+	}
+
 protected:
 	/// Name of the given vector of matrices.
 	std::string array_name;
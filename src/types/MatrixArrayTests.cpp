@@ -103,6 +103,27 @@ TEST(MatrixArray, Serialization) {
 		ASSERT_EQ((*ma1["w"])(i), (*restored_ma["w"])(i));
 }
 
+/*!
+ * Tests products of corresponding matrices of arrays.
+ */
+TEST(MatrixArray, BatchedGemm) {
+	mic::types::MatrixArray<float> w("w", { std::make_tuple ( "W", 3, 4 ), std::make_tuple ( "U", 2, 3 ) });
+	mic::types::MatrixArray<float> d("d", { std::make_tuple ( "W", 3, 5 ), std::make_tuple ( "U", 2, 5 ) });
+	mic::types::MatrixArray<float> g("g", { std::make_tuple ( "W", 4, 5 ), std::make_tuple ( "U", 3, 5 ) });
+	for (size_t i = 0; i < 2; i++) {
+		w[i]->enumerate();
+		d[i]->setValue(1);
+		g[i]->setValue(2);
+	}//: for
+
+	// g = W^T * d + g.
+	mic::types::MatrixArray<float>::batchedGemm(w, d, g, true, false, 1, 1);
+	// Column sums of W (3x4): 3, 12, 21, 30; of U (2x3): 1, 5, 9.
+	ASSERT_EQ((*g["W"])(3, 4), 32);
+	ASSERT_EQ((*g["U"])(1, 0), 7);
+}
+
+
 
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
@@ -31,7 +31,8 @@
 
 // Redefine word "public" so every class field/method will be accessible for tests.
 #define private public
-#include <types/Matrix.hpp>
+#include <types/MatrixTypes.hpp>
+#include <types/Tensor.hpp>
 
 /*!
  * Tests whether matrix has proper dimensions (2x5).
@@ -167,6 +168,232 @@ TEST(Matrix, ArmadilloCompatibilityTest) {
 }
 
 
+/*!
+ * Tests elementwise functions with lambdas, function pointers and row/column vectors.
+ */
+TEST(Matrix, ElementwiseFunctors) {
+	mic::types::Matrix<float> m(3, 4);
+	m.enumerate();
+
+	// Lambda.
+	m.elementwiseFunction([](float x) { return 2 * x; });
+	ASSERT_EQ(m(2, 3), 22);
+
+	// Lambda with scalar.
+	m.elementwiseFunctionScalar([](float x, float s) { return x - s; }, 2.0f);
+	ASSERT_EQ(m(0, 0), -2);
+
+	// Overloaded function name - resolved by the function pointer overload.
+	m.setValue(4);
+	m.elementwiseFunction(std::sqrt);
+	ASSERT_EQ(m(1, 1), 2);
+
+	// Column vector - element (y,x) combined with v(y).
+	Eigen::Matrix<float, Eigen::Dynamic, 1> col(3);
+	col << 1, 2, 3;
+	m.matrixColumnVectorFunction([](float x, float v) { return x * v; }, col);
+	ASSERT_EQ(m(2, 0), 6);
+	ASSERT_EQ(m(0, 3), 2);
+
+	// Row vector - element (y,x) combined with v(x).
+	Eigen::Matrix<float, Eigen::Dynamic, 1> row(4);
+	row << 1, 2, 3, 4;
+	m.matrixRowVectorFunction([](float x, float v) { return x + v; }, row);
+	ASSERT_EQ(m(2, 0), 7);
+	ASSERT_EQ(m(0, 3), 6);
+}
+
+/*!
+ * Tests colwise argmax and top-k - serial and parallel.
+ */
+TEST(Matrix, ColwiseArgMaxTopK) {
+	mic::types::Matrix<float> m(5, 3);
+	m << 1, 9, 3,
+		 7, 2, 3,
+		 5, 9, 8,
+		 7, 4, 1,
+		 0, 6, 2;
+
+	for (size_t threshold : {(size_t)m.size() + 1, (size_t)0}) {
+		mic::types::setParallelThreshold(threshold);
+
+		Eigen::Matrix<size_t, Eigen::Dynamic, 1> indices;
+		Eigen::Matrix<float, Eigen::Dynamic, 1> values;
+		m.colwiseArgMax(indices, values);
+		// Ties are resolved in favour of the first element.
+		ASSERT_EQ(indices(0), 1u);
+		ASSERT_EQ(indices(1), 0u);
+		ASSERT_EQ(indices(2), 2u);
+		ASSERT_EQ(values(0), 7);
+		ASSERT_EQ(values(2), 8);
+		ASSERT_EQ(m.colwiseReturnMaxIndices()(2), 2.0f);
+
+		Eigen::Matrix<size_t, Eigen::Dynamic, Eigen::Dynamic> top_indices;
+		Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> top_values;
+		m.colwiseTopK(3, top_indices, top_values);
+		ASSERT_EQ(top_indices.rows(), 3);
+		ASSERT_EQ(top_indices(0, 0), 1u);
+		ASSERT_EQ(top_indices(1, 0), 3u);
+		ASSERT_EQ(top_indices(2, 0), 2u);
+		ASSERT_EQ(top_values(2, 1), 6);
+		ASSERT_EQ(top_indices(1, 2), 0u);
+		ASSERT_EQ(top_indices(2, 2), 1u);
+	}//: for
+
+	mic::types::setParallelThreshold(mic::types::DEFAULT_PARALLEL_THRESHOLD);
+}
+
+/*!
+ * Tests fused softmax cross entropy, its gradient and the stability for large logits.
+ */
+TEST(Matrix, SoftmaxCrossEntropy) {
+	mic::types::Matrix<double> logits(3, 2);
+	logits << 1, 1000,
+			  2, 0,
+			  3, 1000;
+	mic::types::Matrix<double> targets(3, 2);
+	targets << 0, 1,
+			   0, 0,
+			   1, 0;
+
+	// Column 0: softmax of (1,2,3); column 1: (0.5, 0, 0.5).
+	const double s = exp(1.0) + exp(2.0) + exp(3.0);
+	const double expected = -log(exp(3.0) / s) + log(2.0);
+	ASSERT_NEAR(logits.softmaxCrossEntropy(targets), expected, 1e-12);
+
+	Eigen::MatrixXd gradient;
+	ASSERT_NEAR(logits.softmaxCrossEntropyGradient(targets, gradient), expected, 1e-12);
+	ASSERT_NEAR(gradient(0, 0), exp(1.0) / s, 1e-12);
+	ASSERT_NEAR(gradient(2, 0), exp(3.0) / s - 1, 1e-12);
+	ASSERT_NEAR(gradient(0, 1), -0.5, 1e-12);
+	ASSERT_NEAR(gradient(2, 1), 0.5, 1e-12);
+
+	// Log-softmax.
+	Eigen::MatrixXd log_softmax;
+	logits.colwiseLogSoftmax(log_softmax);
+	ASSERT_NEAR(log_softmax(1, 0), 2 - log(s), 1e-12);
+	ASSERT_NEAR(log_softmax(2, 1), -log(2.0), 1e-12);
+
+	// Cross entropy of probabilities - zeros do not result in NaN/infinity.
+	mic::types::Matrix<float> probabilities(2, 1);
+	probabilities << 0.25, 0;
+	mic::types::Matrix<float> one_hot(2, 1);
+	one_hot << 1, 0;
+	ASSERT_FLOAT_EQ(probabilities.calculateCrossEntropy(one_hot), -logf(0.25f));
+	one_hot << 0, 1;
+	ASSERT_TRUE(std::isfinite(probabilities.calculateCrossEntropy(one_hot)));
+
+	// Targets of different dimensions.
+	mic::types::Matrix<double> wrong_targets(2, 3);
+	ASSERT_THROW(logits.softmaxCrossEntropy(wrong_targets), std::invalid_argument);
+	ASSERT_THROW(logits.softmaxCrossEntropyGradient(wrong_targets, gradient), std::invalid_argument);
+	ASSERT_THROW(probabilities.calculateCrossEntropy(mic::types::Matrix<float>(1, 2)), std::invalid_argument);
+}
+
+/*!
+ * Tests broadcast operations with column and row vectors.
+ */
+TEST(Matrix, Broadcast) {
+	mic::types::Matrix<float> m(2, 3);
+	Eigen::Matrix<float, Eigen::Dynamic, 1> col(2);
+	col << 1, 2;
+	Eigen::Matrix<float, Eigen::Dynamic, 1> row(3);
+	row << 1, 2, 4;
+
+	for (size_t threshold : {(size_t)m.size() + 1, (size_t)0}) {
+		mic::types::setParallelThreshold(threshold);
+
+		// Columns equal to (1,2).
+		m.repeatVector(col);
+		ASSERT_EQ(m(1, 2), 2);
+		m.colwiseAdd(col);
+		ASSERT_EQ(m(0, 1), 2);
+		ASSERT_EQ(m(1, 1), 4);
+		m.colwiseMul(col);
+		ASSERT_EQ(m(1, 0), 8);
+		m.colwiseDiv(col);
+		m.colwiseSub(col);
+		ASSERT_EQ(m(1, 2), 2);
+
+		m.rowwiseMul(row);
+		ASSERT_EQ(m(1, 2), 8);
+		ASSERT_EQ(m(0, 1), 2);
+		m.rowwiseAdd(row);
+		ASSERT_EQ(m(0, 2), 8);
+		m.rowwiseSub(row);
+		m.rowwiseDiv(row);
+		ASSERT_EQ(m(1, 1), 2);
+	}//: for
+
+	mic::types::setParallelThreshold(mic::types::DEFAULT_PARALLEL_THRESHOLD);
+
+	// Sizes of vectors must match.
+	ASSERT_THROW(m.colwiseAdd(row), std::invalid_argument);
+	ASSERT_THROW(m.rowwiseAdd(col), std::invalid_argument);
+	ASSERT_THROW(m.matrixColumnVectorFunction([](float x, float v) { return x * v; }, row), std::invalid_argument);
+}
+
+/*!
+ * Tests matrix products with transpositions and accumulation (gemm), matrix-vector products (gemv) and batched products of tensor slices.
+ */
+TEST(Matrix, Products) {
+	mic::types::MatrixXd w(4, 3);
+	w.randn();
+	mic::types::MatrixXd d(4, 5);
+	d.randn();
+	mic::types::MatrixXd x(3, 5);
+	x.randn();
+	const double eps = 1e-12;
+
+	// W^T * delta.
+	mic::types::MatrixXd c;
+	mic::types::MatrixXd::gemm(w, d, c, true);
+	ASSERT_EQ(c.rows(), 3);
+	ASSERT_EQ(c.cols(), 5);
+	ASSERT_LE((c - w.transpose() * d).norm(), eps);
+
+	// Accumulation: C = 2 * delta * x^T + 0.5 * C.
+	mic::types::MatrixXd acc(4, 3);
+	acc.setValue(1);
+	mic::types::MatrixXd::gemm(d, x, acc, false, true, 2, 0.5);
+	Eigen::MatrixXd expected = 2 * d * x.transpose();
+	expected.array() += 0.5;
+	ASSERT_LE((acc - expected).norm(), eps);
+
+	// Mismatched dimensions.
+	ASSERT_THROW(mic::types::MatrixXd::gemm(w, d, c), std::invalid_argument);
+	ASSERT_THROW(mic::types::MatrixXd::gemm(w, d, acc, true, false, 1, 1), std::invalid_argument);
+
+	// Matrix-vector products.
+	Eigen::VectorXd v = Eigen::VectorXd::Random(4);
+	Eigen::VectorXd y;
+	mic::types::MatrixXd::gemv(w, v, y, true);
+	ASSERT_LE((y - w.transpose() * v).norm(), eps);
+	Eigen::VectorXd u = Eigen::VectorXd::Random(3);
+	Eigen::VectorXd z = Eigen::VectorXd::Ones(4);
+	mic::types::MatrixXd::gemv(w, u, z, false, 1, -1);
+	ASSERT_LE((z - (w * u - Eigen::VectorXd::Ones(4))).norm(), eps);
+
+	// Batched products of 2D slices of tensors - also in parallel.
+	mic::types::Tensor<double> a({3, 4, 6});
+	a.randn();
+	mic::types::Tensor<double> b({3, 2, 6});
+	b.randn();
+	for (size_t threshold : {(size_t)1 << 30, (size_t)0}) {
+		mic::types::setParallelThreshold(threshold);
+		mic::types::Tensor<double> p;
+		mic::types::MatrixXd::batchedGemm(a, b, p, true);
+		ASSERT_EQ(p.dims(), std::vector<size_t>({4, 2, 6}));
+		for (size_t i = 0; i < 6; i++) {
+			Eigen::Map<Eigen::MatrixXd> as(a.data() + i * 12, 3, 4);
+			Eigen::Map<Eigen::MatrixXd> bs(b.data() + i * 6, 3, 2);
+			Eigen::Map<Eigen::MatrixXd> ps(p.data() + i * 8, 4, 2);
+			ASSERT_LE((ps - as.transpose() * bs).norm(), eps);
+		}//: for
+	}//: for
+	mic::types::setParallelThreshold(mic::types::DEFAULT_PARALLEL_THRESHOLD);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -32,6 +32,44 @@
 namespace mic {
 namespace types {
 
+#ifdef OpenBLAS_FOUND
+/*!
+ * \brief Template specialization: matrix product kernel - for doubles. Uses OpenBLAS (cblas_dgemm) with transpositions and accumulation.
+ * \author tkornuta
+ */
+template<>
+inline void mic::types::Matrix<double>::gemmKernel(const double* a_, const double* b_, double* c_, size_t m_, size_t n_, size_t k_, bool transpose_a_, bool transpose_b_, double alpha_, double beta_) {
+	// Leading dimensions of column-major blocks (BLAS requires them to be at least 1).
+	const size_t lda = std::max<size_t>(1, transpose_a_ ? k_ : m_);
+	const size_t ldb = std::max<size_t>(1, transpose_b_ ? n_ : k_);
+	const size_t ldc = std::max<size_t>(1, m_);
+
+	cblas_dgemm( CblasColMajor, transpose_a_ ? CblasTrans : CblasNoTrans, transpose_b_ ? CblasTrans : CblasNoTrans, m_, n_, k_, alpha_,
+			a_, lda,
+			b_, ldb, beta_, c_, ldc );
+}
+
+/*!
+ * \brief Template specialization: OpenBLAS runs its own threads - for doubles.
+ * \author tkornuta
+ */
+template<>
+inline bool mic::types::Matrix<double>::threadedGemmKernel() {
+	return true;
+}
+
+/*!
+ * \brief Template specialization: matrix-vector product kernel - for doubles. Uses OpenBLAS (cblas_dgemv) with transposition and accumulation.
+ * \author tkornuta
+ */
+template<>
+inline void mic::types::Matrix<double>::gemvKernel(const double* a_, size_t rows_, size_t cols_, const double* x_, double* y_, bool transpose_, double alpha_, double beta_) {
+	cblas_dgemv( CblasColMajor, transpose_ ? CblasTrans : CblasNoTrans, rows_, cols_, alpha_,
+			a_, std::max<size_t>(1, rows_),
+			x_, 1, beta_, y_, 1 );
+}
+#endif
+
 /*!
  * \brief Template specialization: overloaded matrix multiplication operator - for doubles. Uses OpenBLAS if found by CMAKE.
  * \author tkornuta
@@ -49,9 +87,7 @@ inline Eigen::MatrixXd mic::types::Matrix<double>::operator *(const Eigen::Matri
 	// Create temporary matrix.
 	Eigen::MatrixXd c(M,N);
 
-	cblas_dgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0,
-			this->data(), M,
-			mat_.data(), K, 0.0, c.data(), M );
+	gemmKernel(this->data(), mat_.data(), c.data(), M, N, K, false, false, 1, 0);
 	return c;
 #else
 	// Calling base EIGEN operator *
@@ -35,6 +35,44 @@
 namespace mic {
 namespace types {
 
+#ifdef OpenBLAS_FOUND
+/*!
+ * \brief Template specialization: matrix product kernel - for floats. Uses OpenBLAS (cblas_sgemm) with transpositions and accumulation.
+ * \author tkornuta
+ */
+template<>
+inline void mic::types::Matrix<float>::gemmKernel(const float* a_, const float* b_, float* c_, size_t m_, size_t n_, size_t k_, bool transpose_a_, bool transpose_b_, float alpha_, float beta_) {
+	// Leading dimensions of column-major blocks (BLAS requires them to be at least 1).
+	const size_t lda = std::max<size_t>(1, transpose_a_ ? k_ : m_);
+	const size_t ldb = std::max<size_t>(1, transpose_b_ ? n_ : k_);
+	const size_t ldc = std::max<size_t>(1, m_);
+
+	cblas_sgemm( CblasColMajor, transpose_a_ ? CblasTrans : CblasNoTrans, transpose_b_ ? CblasTrans : CblasNoTrans, m_, n_, k_, alpha_,
+			a_, lda,
+			b_, ldb, beta_, c_, ldc );
+}
+
+/*!
+ * \brief Template specialization: OpenBLAS runs its own threads - for floats.
+ * \author tkornuta
+ */
+template<>
+inline bool mic::types::Matrix<float>::threadedGemmKernel() {
+	return true;
+}
+
+/*!
+ * \brief Template specialization: matrix-vector product kernel - for floats. Uses OpenBLAS (cblas_sgemv) with transposition and accumulation.
+ * \author tkornuta
+ */
+template<>
+inline void mic::types::Matrix<float>::gemvKernel(const float* a_, size_t rows_, size_t cols_, const float* x_, float* y_, bool transpose_, float alpha_, float beta_) {
+	cblas_sgemv( CblasColMajor, transpose_ ? CblasTrans : CblasNoTrans, rows_, cols_, alpha_,
+			a_, std::max<size_t>(1, rows_),
+			x_, 1, beta_, y_, 1 );
+}
+#endif
+
 /*!
  * \brief Template specialization: overloaded matrix multiplication operator - for floats. Uses OpenBLAS if found by CMAKE.
  * \author tkornuta
@@ -53,9 +91,7 @@ inline Eigen::MatrixXf mic::types::Matrix<float>::operator *(
 	// Create temporary matrix.
 	Eigen::MatrixXf c(M,N);
 
-	cblas_sgemm( CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0,
-			this->data(), M,
-			mat_.data(), K, 0.0, c.data(), M );
+	gemmKernel(this->data(), mat_.data(), c.data(), M, N, K, false, false, 1, 0);
 	return c;
 #else
 	// Calling base EIGEN operator *
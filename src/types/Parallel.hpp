@@ -0,0 +1,116 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Parallel.hpp
+ * \brief Contains the policy deciding whether the (OpenMP-parallelized) kernels of Tensor and Matrix run in parallel.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_PARALLEL_HPP_
+#define SRC_TYPES_PARALLEL_HPP_
+
+#include <cstddef>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Default minimal number of elements for which a kernel is executed in parallel - below it the cost of waking up the threads dominates.
+ * \author tkornuta
+ */
+const size_t DEFAULT_PARALLEL_THRESHOLD = 32768;
+
+/*!
+ * Returns reference to the (global) threshold - minimal number of elements processed by a kernel in parallel.
+ * @return Reference to the threshold.
+ */
+inline size_t& parallelThreshold() {
+	static size_t threshold = DEFAULT_PARALLEL_THRESHOLD;
+	return threshold;
+}
+
+/*!
+ * Sets the minimal number of elements for which kernels are executed in parallel.
+ * @param threshold_ Number of elements (0 - always parallel).
+ */
+inline void setParallelThreshold(size_t threshold_) {
+	parallelThreshold() = threshold_;
+}
+
+/*!
+ * Returns the minimal number of elements for which kernels are executed in parallel.
+ * @return Number of elements.
+ */
+inline size_t getParallelThreshold() {
+	return parallelThreshold();
+}
+
+/*!
+ * Sets the number of threads used by parallel kernels. If OpenMP is not enabled it does nothing.
+ * @param threads_ Number of threads (must be > 0).
+ */
+inline void setNumberOfThreads(int threads_) {
+#ifdef _OPENMP
+	if (threads_ > 0)
+		omp_set_num_threads(threads_);
+#else
+	(void)threads_;
+#endif
+}
+
+/*!
+ * Returns the number of threads used by parallel kernels (1 if OpenMP is not enabled).
+ * @return Number of threads.
+ */
+inline int getNumberOfThreads() {
+#ifdef _OPENMP
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+
+/*!
+ * Returns the index of the current thread (0 if OpenMP is not enabled or outside of parallel region).
+ * @return Index of the thread.
+ */
+inline int getThreadIndex() {
+#ifdef _OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+/*!
+ * Decides whether a kernel processing given number of elements should be executed in parallel.
+ * Used in the "if" clauses of the OpenMP pragmas, e.g. "#pragma omp parallel for if(mic::types::useParallel(elements))".
+ * @param elements_ Number of processed elements.
+ * @return True if the kernel should be executed in parallel.
+ */
+inline bool useParallel(size_t elements_) {
+	return (elements_ >= parallelThreshold());
+}
+
+} //: namespace types
+} //: namespace mic
+
+#endif /* SRC_TYPES_PARALLEL_HPP_ */
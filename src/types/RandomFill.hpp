@@ -0,0 +1,255 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file RandomFill.hpp
+ * \brief Contains a counter-based (Philox4x32-10) random number generator and (parallel) functions filling memory blocks with random numbers.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_RANDOMFILL_HPP_
+#define SRC_TYPES_RANDOMFILL_HPP_
+
+#include <types/Parallel.hpp>
+
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include <random>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC'11).
+ * The generator has no state - it is a bijection transforming a 128-bit counter into four 32-bit random numbers under a 64-bit key.
+ * Hence every element of a block can be generated independently, which makes the result independent of the number of threads.
+ * \author tkornuta
+ */
+class Philox4x32 {
+public:
+	/*!
+	 * Generates four random numbers for given counter and key.
+	 * @param ctr_ Counter (4x32 bits).
+	 * @param key_ Key (2x32 bits).
+	 * @param out_ Output table for four random numbers.
+	 */
+	static inline void generate(const uint32_t ctr_[4], const uint32_t key_[2], uint32_t out_[4]) {
+		uint32_t c0 = ctr_[0], c1 = ctr_[1], c2 = ctr_[2], c3 = ctr_[3];
+		uint32_t k0 = key_[0], k1 = key_[1];
+		for (size_t r = 0; r < 10; r++) {
+			uint64_t p0 = (uint64_t)M0 * c0;
+			uint64_t p1 = (uint64_t)M1 * c2;
+			uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+			uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+			c1 = (uint32_t)p1;
+			c3 = (uint32_t)p0;
+			c0 = n0;
+			c2 = n2;
+			// Bump the key.
+			k0 += W0;
+			k1 += W1;
+		}//: for
+		out_[0] = c0;
+		out_[1] = c1;
+		out_[2] = c2;
+		out_[3] = c3;
+	}
+
+	/*!
+	 * Generates four random numbers for given block index, stream and seed.
+	 * @param block_ Index of the block (lower half of the counter).
+	 * @param stream_ Index of the stream (upper half of the counter).
+	 * @param seed_ Seed (key).
+	 * @param out_ Output table for four random numbers.
+	 */
+	static inline void generate(uint64_t block_, uint64_t stream_, uint64_t seed_, uint32_t out_[4]) {
+		const uint32_t ctr[4] = { (uint32_t)block_, (uint32_t)(block_ >> 32), (uint32_t)stream_, (uint32_t)(stream_ >> 32) };
+		const uint32_t key[2] = { (uint32_t)seed_, (uint32_t)(seed_ >> 32) };
+		generate(ctr, key, out_);
+	}
+
+private:
+	/// Multiplier of the first half of the counter.
+	static const uint32_t M0 = 0xD2511F53;
+
+	/// Multiplier of the second half of the counter.
+	static const uint32_t M1 = 0xCD9E8D57;
+
+	/// Weyl sequence increment of the first half of the key.
+	static const uint32_t W0 = 0x9E3779B9;
+
+	/// Weyl sequence increment of the second half of the key.
+	static const uint32_t W1 = 0xBB67AE85;
+};
+
+
+/*!
+ * Converts a 32-bit random integer into a real number from the open range (0, 1).
+ * @tparam T Type of the real number.
+ * @param x_ Random integer.
+ * @return Random real.
+ */
+template<typename T>
+inline T uniformOpen(uint32_t x_) {
+	return (T)((x_ + 0.5) * 2.3283064365386963e-10);
+}
+
+/*!
+ * Converts a 32-bit random integer into a float from the open range (0, 1) - uses 24 upper bits, so the result is never rounded to 1.
+ * @param x_ Random integer.
+ * @return Random float.
+ */
+template<>
+inline float uniformOpen<float>(uint32_t x_) {
+	return ((x_ >> 8) + 0.5f) * 5.9604644775390625e-08f;
+}
+
+
+/*!
+ * Returns reference to the (global) seed used by the random fills. Initially it is taken from random device.
+ * @return Reference to the seed.
+ */
+inline uint64_t& randomSeed() {
+	static uint64_t seed = ((uint64_t)std::random_device()() << 32) ^ std::random_device()();
+	return seed;
+}
+
+/*!
+ * Returns reference to the (global) counter of streams - every fill uses a fresh stream, so consecutive fills differ.
+ * @return Reference to the counter.
+ */
+inline std::atomic<uint64_t>& randomStream() {
+	static std::atomic<uint64_t> stream(0);
+	return stream;
+}
+
+/*!
+ * Sets the seed of random fills and resets the counter of streams - after that the sequence of fills is reproducible.
+ * @param seed_ The seed.
+ */
+inline void setRandomSeed(uint64_t seed_) {
+	randomSeed() = seed_;
+	randomStream() = 0;
+}
+
+/*!
+ * Returns the seed of random fills.
+ * @return The seed.
+ */
+inline uint64_t getRandomSeed() {
+	return randomSeed();
+}
+
+/*!
+ * Returns the next stream index.
+ * @return Stream index.
+ */
+inline uint64_t nextRandomStream() {
+	return randomStream().fetch_add(1);
+}
+
+
+/*!
+ * Fills memory with random numbers from range <min, max) - uniform distribution.
+ * Element i is generated from block i/4 of the given stream, so the result does not depend on the number of threads.
+ * @tparam T Type of elements (float or double).
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements.
+ * @param min_ Min value.
+ * @param max_ Max value.
+ * @param seed_ Seed.
+ * @param stream_ Index of the stream.
+ */
+template<typename T>
+void fillUniform(T* data_, size_t size_, T min_, T max_, uint64_t seed_, uint64_t stream_) {
+	const T range = max_ - min_;
+	const size_t blocks = (size_ + 3) / 4;
+
+#pragma omp parallel for if(mic::types::useParallel(size_))
+	for (size_t b = 0; b < blocks; b++) {
+		uint32_t r[4];
+		Philox4x32::generate(b, stream_, seed_, r);
+		const size_t n = (4*b + 4 <= size_) ? 4 : size_ - 4*b;
+		for (size_t j = 0; j < n; j++)
+			data_[4*b + j] = min_ + range * uniformOpen<T>(r[j]);
+	}//: for
+}
+
+/*!
+ * Fills memory with random numbers from range <min, max) - uniform distribution. Uses global seed and the next stream.
+ * @tparam T Type of elements (float or double).
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements.
+ * @param min_ Min value.
+ * @param max_ Max value.
+ */
+template<typename T>
+void fillUniform(T* data_, size_t size_, T min_ = 0, T max_ = 1) {
+	fillUniform(data_, size_, min_, max_, getRandomSeed(), nextRandomStream());
+}
+
+
+/*!
+ * Fills memory with random numbers with a normal distribution. Uses Box-Muller transform - every block of four uniform numbers gives four normal ones.
+ * Element i is generated from block i/4 of the given stream, so the result does not depend on the number of threads.
+ * @tparam T Type of elements (float or double).
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements.
+ * @param mean_ Mean.
+ * @param stddev_ Standard deviation.
+ * @param seed_ Seed.
+ * @param stream_ Index of the stream.
+ */
+template<typename T>
+void fillNormal(T* data_, size_t size_, T mean_, T stddev_, uint64_t seed_, uint64_t stream_) {
+	const T two_pi = (T)6.283185307179586;
+	const size_t blocks = (size_ + 3) / 4;
+
+#pragma omp parallel for if(mic::types::useParallel(size_))
+	for (size_t b = 0; b < blocks; b++) {
+		uint32_t r[4];
+		Philox4x32::generate(b, stream_, seed_, r);
+		T out[4];
+		for (size_t j = 0; j < 4; j += 2) {
+			T radius = std::sqrt((T)-2 * std::log(uniformOpen<T>(r[j])));
+			T angle = two_pi * uniformOpen<T>(r[j+1]);
+			out[j] = radius * std::cos(angle);
+			out[j+1] = radius * std::sin(angle);
+		}//: for
+		const size_t n = (4*b + 4 <= size_) ? 4 : size_ - 4*b;
+		for (size_t j = 0; j < n; j++)
+			data_[4*b + j] = mean_ + stddev_ * out[j];
+	}//: for
+}
+
+/*!
+ * Fills memory with random numbers with a normal distribution. Uses global seed and the next stream.
+ * @tparam T Type of elements (float or double).
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements.
+ * @param mean_ Mean.
+ * @param stddev_ Standard deviation.
+ */
+template<typename T>
+void fillNormal(T* data_, size_t size_, T mean_ = 0, T stddev_ = 1) {
+	fillNormal(data_, size_, mean_, stddev_, getRandomSeed(), nextRandomStream());
+}
+
+} //: namespace types
+} //: namespace mic
+
+#endif /* SRC_TYPES_RANDOMFILL_HPP_ */
@@ -0,0 +1,462 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Reductions.hpp
+ * \brief Contains (parallel) reduction kernels operating on memory blocks - sums, extrema and their positions, both full and along an axis.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_REDUCTIONS_HPP_
+#define SRC_TYPES_REDUCTIONS_HPP_
+
+#include <types/Parallel.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Number of elements reduced by a single task of parallel reductions.
+ * The partition of data into blocks does not depend on the number of threads, hence the results are reproducible.
+ */
+const size_t REDUCTION_BLOCK = 16384;
+
+/*!
+ * \brief Number of elements below which the pairwise summation switches to a (vectorized) loop.
+ */
+const size_t PAIRWISE_BLOCK = 128;
+
+
+/*!
+ * \brief Transformation of elements summed by reductions - identity.
+ */
+struct IdentityTransform {
+	/// Returns the element.
+	inline double operator()(double x_) const { return x_; }
+
+	/// Returns the element (ignoring its output position).
+	inline double operator()(double x_, size_t) const { return x_; }
+};
+
+/*!
+ * \brief Transformation of elements summed by reductions - absolute value.
+ */
+struct AbsTransform {
+	/// Returns the absolute value of the element.
+	inline double operator()(double x_) const { return std::fabs(x_); }
+
+	/// Returns the absolute value of the element (ignoring its output position).
+	inline double operator()(double x_, size_t) const { return std::fabs(x_); }
+};
+
+/*!
+ * \brief Transformation of elements summed by reductions - square.
+ */
+struct SquareTransform {
+	/// Returns the square of the element.
+	inline double operator()(double x_) const { return x_ * x_; }
+
+	/// Returns the square of the element (ignoring its output position).
+	inline double operator()(double x_, size_t) const { return x_ * x_; }
+};
+
+/*!
+ * \brief Transformation of elements summed by reductions - squared deviation from mean(s).
+ */
+struct SquaredDeviationTransform {
+	/// Mean (used when the output position is not given).
+	double mean;
+
+	/// Means of outputs (used when the output position is given).
+	const double* means;
+
+	/// Returns the squared deviation of the element from the mean.
+	inline double operator()(double x_) const { return (x_ - mean) * (x_ - mean); }
+
+	/// Returns the squared deviation of the element from the mean of the output.
+	inline double operator()(double x_, size_t j_) const { return (x_ - means[j_]) * (x_ - means[j_]); }
+};
+
+
+/*!
+ * Sums (transformed) elements with pairwise summation - the error grows with O(log n) instead of O(n).
+ * The elements are accumulated in double precision, in the base case in eight independent lanes, so the loop can be vectorized.
+ * @tparam T Type of elements.
+ * @tparam F Type of the transformation.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements.
+ * @param f_ Transformation applied to every element.
+ * @return Sum.
+ */
+template<typename T, typename F>
+double pairwiseSum(const T* data_, size_t size_, F f_) {
+	if (size_ <= PAIRWISE_BLOCK) {
+		double lanes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		size_t i = 0;
+		for (; i + 8 <= size_; i += 8)
+			for (size_t l = 0; l < 8; l++)
+				lanes[l] += f_((double)data_[i + l]);
+		double sum = 0;
+		for (; i < size_; i++)
+			sum += f_((double)data_[i]);
+		return sum + ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	}//: if
+	// Split in half - keeping the left part a multiple of eight.
+	size_t half = (size_ / 2 + 7) & ~(size_t)7;
+	return pairwiseSum(data_, half, f_) + pairwiseSum(data_ + half, size_ - half, f_);
+}
+
+/*!
+ * Sums (transformed) elements - in parallel, block by block (pairwise within blocks), then pairwise over partial sums of blocks.
+ * @tparam T Type of elements.
+ * @tparam F Type of the transformation.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements.
+ * @param f_ Transformation applied to every element.
+ * @return Sum.
+ */
+template<typename T, typename F>
+double reduceSum(const T* data_, size_t size_, F f_) {
+	const size_t blocks = (size_ + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK;
+	if (blocks <= 1)
+		return pairwiseSum(data_, size_, f_);
+
+	std::vector<double> partial(blocks);
+#pragma omp parallel for if(mic::types::useParallel(size_))
+	for (size_t b = 0; b < blocks; b++) {
+		const size_t begin = b * REDUCTION_BLOCK;
+		partial[b] = pairwiseSum(data_ + begin, std::min(REDUCTION_BLOCK, size_ - begin), f_);
+	}//: for
+	return pairwiseSum(partial.data(), blocks, IdentityTransform());
+}
+
+/*!
+ * Returns the maximal element of a (small) block - serial, vectorized version, used e.g. by kernels that are parallelized over blocks.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be > 0).
+ * @return Maximal element.
+ */
+template<typename T>
+T blockMax(const T* data_, size_t size_) {
+	T max = data_[0];
+#pragma omp simd reduction(max:max)
+	for (size_t i = 0; i < size_; i++)
+		max = (data_[i] > max) ? data_[i] : max;
+	return max;
+}
+
+/*!
+ * Returns the position of the (first) maximal element of a (small) block - the maximum is found by a vectorized reduction, then its first occurrence is searched for.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be > 0).
+ * @param max_ Returned maximal element.
+ * @return Position of the maximal element (0 if the block contains only NaNs).
+ */
+template<typename T>
+size_t blockArgMax(const T* data_, size_t size_, T& max_) {
+	max_ = blockMax(data_, size_);
+	const size_t index = std::find(data_, data_ + size_, max_) - data_;
+	return (index < size_) ? index : 0;
+}
+
+/*!
+ * Finds k maximal elements of a (small) block and their positions, sorted in descending order (ties are resolved in favour of lower positions).
+ * The candidates are kept in a sorted buffer - an element is inserted only if it is greater than the smallest candidate, hence the cost is close to a single scan for k << size.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be >= k_).
+ * @param k_ Number of searched elements.
+ * @param values_ Output table of k maximal elements.
+ * @param positions_ Output table of k positions.
+ */
+template<typename T>
+void blockTopK(const T* data_, size_t size_, size_t k_, T* values_, size_t* positions_) {
+	assert((k_ > 0) && (k_ <= size_));
+	// Fill the buffer with the first k elements.
+	for (size_t i = 0; i < k_; i++) {
+		size_t j = i;
+		for (; (j > 0) && (data_[i] > values_[j - 1]); j--) {
+			values_[j] = values_[j - 1];
+			positions_[j] = positions_[j - 1];
+		}//: for
+		values_[j] = data_[i];
+		positions_[j] = i;
+	}//: for
+
+	// Insert greater elements.
+	for (size_t i = k_; i < size_; i++) {
+		if (!(data_[i] > values_[k_ - 1]))
+			continue;
+		size_t j = k_ - 1;
+		for (; (j > 0) && (data_[i] > values_[j - 1]); j--) {
+			values_[j] = values_[j - 1];
+			positions_[j] = positions_[j - 1];
+		}//: for
+		values_[j] = data_[i];
+		positions_[j] = i;
+	}//: for
+}
+
+/*!
+ * Returns the maximal element.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be > 0).
+ * @return Maximal element.
+ */
+template<typename T>
+T reduceMax(const T* data_, size_t size_) {
+	T max = data_[0];
+#pragma omp parallel for simd reduction(max:max) if(mic::types::useParallel(size_))
+	for (size_t i = 0; i < size_; i++)
+		max = (data_[i] > max) ? data_[i] : max;
+	return max;
+}
+
+/*!
+ * Returns the minimal element.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be > 0).
+ * @return Minimal element.
+ */
+template<typename T>
+T reduceMin(const T* data_, size_t size_) {
+	T min = data_[0];
+#pragma omp parallel for simd reduction(min:min) if(mic::types::useParallel(size_))
+	for (size_t i = 0; i < size_; i++)
+		min = (data_[i] < min) ? data_[i] : min;
+	return min;
+}
+
+/*!
+ * Returns the position of the (first) maximal element - the maximum is found by a (vectorized, parallel) reduction, then its first occurrence is searched for.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be > 0).
+ * @return Position of the maximal element (0 if the maximum is NaN, as it cannot be found).
+ */
+template<typename T>
+size_t reduceArgMax(const T* data_, size_t size_) {
+	const T max = reduceMax(data_, size_);
+	const size_t index = std::find(data_, data_ + size_, max) - data_;
+	return (index < size_) ? index : 0;
+}
+
+/*!
+ * Returns the position of the (first) minimal element.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param size_ Number of elements (must be > 0).
+ * @return Position of the minimal element (0 if the minimum is NaN, as it cannot be found).
+ */
+template<typename T>
+size_t reduceArgMin(const T* data_, size_t size_) {
+	const T min = reduceMin(data_, size_);
+	const size_t index = std::find(data_, data_ + size_, min) - data_;
+	return (index < size_) ? index : 0;
+}
+
+
+/*!
+ * Sums (transformed) rows of elements with pairwise summation over rows - the rows are split in halves recursively, blocks of up to PAIRWISE_BLOCK rows are accumulated element by element, so the loop can be vectorized along the row.
+ * @tparam T Type of elements.
+ * @tparam F Type of the transformation - called with element and its position in the row.
+ * @param data_ Pointer to the first element of the first row.
+ * @param rows_ Number of rows.
+ * @param stride_ Distance between consecutive rows.
+ * @param width_ Number of summed elements of every row.
+ * @param f_ Transformation applied to every element.
+ * @param out_ Output table of width_ sums.
+ * @param scratch_ Buffer for partial sums - width_ elements for every level of the recursion (see pairwiseLevels()).
+ */
+template<typename T, typename F>
+void pairwiseSumRows(const T* data_, size_t rows_, size_t stride_, size_t width_, F f_, double* out_, double* scratch_) {
+	if (rows_ <= PAIRWISE_BLOCK) {
+		for (size_t i = 0; i < width_; i++)
+			out_[i] = 0;
+		for (size_t k = 0; k < rows_; k++) {
+			const T* row = data_ + k * stride_;
+			for (size_t i = 0; i < width_; i++)
+				out_[i] += f_((double)row[i], i);
+		}//: for
+		return;
+	}//: if
+	// Left half is summed into the output, right half into the scratch buffer (deeper levels use the remaining part of the buffer).
+	const size_t half = rows_ / 2;
+	pairwiseSumRows(data_, half, stride_, width_, f_, out_, scratch_ + width_);
+	pairwiseSumRows(data_ + half * stride_, rows_ - half, stride_, width_, f_, scratch_, scratch_ + width_);
+	for (size_t i = 0; i < width_; i++)
+		out_[i] += scratch_[i];
+}
+
+/*!
+ * Returns the number of levels of recursion of pairwiseSumRows(), i.e. the number of rows of the scratch buffer it requires.
+ * @param rows_ Number of summed rows.
+ */
+inline size_t pairwiseLevels(size_t rows_) {
+	size_t levels = 1;
+	for (; rows_ > PAIRWISE_BLOCK; rows_ -= rows_ / 2)
+		levels++;
+	return levels;
+}
+
+/*!
+ * Sums (transformed) elements along an axis. Data is treated as a 3D block [inner x dim x outer] (inner being the fastest changing), reduced along the middle dimension into [inner x outer] outputs.
+ * The outputs are computed with pairwise summation, so the error grows with O(log dim) instead of O(dim).
+ * If the reduced axis is the fastest changing one, every output is a pairwise sum of a contiguous block; otherwise whole (contiguous) rows of inner elements are summed pairwise, so the loop can be vectorized.
+ * @tparam T Type of elements.
+ * @tparam F Type of the transformation - called with element and position of the output.
+ * @param data_ Pointer to data.
+ * @param inner_ Product of dimensions preceding the axis.
+ * @param dim_ Size of the reduced axis.
+ * @param outer_ Product of dimensions following the axis.
+ * @param f_ Transformation applied to every element.
+ * @param out_ Output table of inner x outer sums.
+ */
+template<typename T, typename F>
+void reduceSumAxis(const T* data_, size_t inner_, size_t dim_, size_t outer_, F f_, double* out_) {
+	if (inner_ == 1) {
+#pragma omp parallel for if(mic::types::useParallel(dim_ * outer_))
+		for (size_t o = 0; o < outer_; o++)
+			out_[o] = pairwiseSum(data_ + o * dim_, dim_, [&f_, o](double x_) { return f_(x_, o); });
+		return;
+	}//: if
+
+	// Split rows into chunks, so the work can be parallelized also when there is a single outer block.
+	const size_t chunk = 1024;
+	const size_t chunks = (inner_ + chunk - 1) / chunk;
+	const size_t levels = pairwiseLevels(dim_);
+#pragma omp parallel for if(mic::types::useParallel(inner_ * dim_ * outer_))
+	for (size_t p = 0; p < outer_ * chunks; p++) {
+		const size_t o = p / chunks;
+		const size_t begin = (p % chunks) * chunk;
+		const size_t width = std::min(inner_, begin + chunk) - begin;
+		std::vector<double> scratch(levels * width);
+		const size_t offset = o * inner_ + begin;
+		pairwiseSumRows(data_ + o * dim_ * inner_ + begin, dim_, inner_, width,
+				[&f_, offset](double x_, size_t i_) { return f_(x_, offset + i_); }, out_ + offset, scratch.data());
+	}//: for
+}
+
+/*!
+ * Finds extrema (minima or maxima) and their positions along an axis. Data is treated as a 3D block [inner x dim x outer], reduced along the middle dimension.
+ * @tparam T Type of elements.
+ * @tparam Max Flag indicating whether maxima (true) or minima (false) are searched for.
+ * @param data_ Pointer to data.
+ * @param inner_ Product of dimensions preceding the axis.
+ * @param dim_ Size of the reduced axis.
+ * @param outer_ Product of dimensions following the axis.
+ * @param values_ Output table of inner x outer extrema.
+ * @param positions_ Output table of inner x outer positions of extrema along the axis (can be nullptr).
+ */
+template<typename T, bool Max>
+void reduceExtremumAxis(const T* data_, size_t inner_, size_t dim_, size_t outer_, T* values_, size_t* positions_) {
+	const size_t chunk = 1024;
+	const size_t chunks = (inner_ + chunk - 1) / chunk;
+#pragma omp parallel for if(mic::types::useParallel(inner_ * dim_ * outer_))
+	for (size_t p = 0; p < outer_ * chunks; p++) {
+		const size_t o = p / chunks;
+		const size_t begin = (p % chunks) * chunk;
+		const size_t end = std::min(inner_, begin + chunk);
+		T* values = values_ + o * inner_;
+		size_t* positions = (positions_ != nullptr) ? positions_ + o * inner_ : nullptr;
+
+		// Initialize with the first row.
+		const T* row = data_ + o * dim_ * inner_;
+		for (size_t i = begin; i < end; i++)
+			values[i] = row[i];
+		if (positions != nullptr)
+			for (size_t i = begin; i < end; i++)
+				positions[i] = 0;
+
+		for (size_t k = 1; k < dim_; k++) {
+			row = data_ + (o * dim_ + k) * inner_;
+			if (positions == nullptr) {
+				for (size_t i = begin; i < end; i++)
+					values[i] = (Max ? (row[i] > values[i]) : (row[i] < values[i])) ? row[i] : values[i];
+			} else {
+				for (size_t i = begin; i < end; i++) {
+					const bool better = Max ? (row[i] > values[i]) : (row[i] < values[i]);
+					values[i] = better ? row[i] : values[i];
+					positions[i] = better ? k : positions[i];
+				}//: for
+			}//: else
+		}//: for
+	}//: for
+}
+
+/*!
+ * Computes means and (population) variances of slices along an axis (e.g. per-channel statistics of images). Data is treated as a 3D block [inner x dim x outer], every slice being dim-th "column" of outer blocks of inner elements.
+ * Uses two passes (mean, then squared deviations) with pairwise summation of contiguous blocks.
+ * @tparam T Type of elements.
+ * @param data_ Pointer to data.
+ * @param inner_ Product of dimensions preceding the axis.
+ * @param dim_ Size of the axis (number of slices).
+ * @param outer_ Product of dimensions following the axis.
+ * @param means_ Output table of dim means.
+ * @param variances_ Output table of dim variances.
+ */
+template<typename T>
+void reduceSliceMeanVariance(const T* data_, size_t inner_, size_t dim_, size_t outer_, double* means_, double* variances_) {
+	// Tasks: blocks of (at most) REDUCTION_BLOCK elements of every (outer, slice) pair.
+	const size_t parts = (inner_ + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK;
+	const size_t tasks = outer_ * dim_ * parts;
+	const double count = (double)inner_ * outer_;
+	std::vector<double> partial(tasks);
+
+	for (size_t pass = 0; pass < 2; pass++) {
+		SquaredDeviationTransform deviation;
+		deviation.means = means_;
+#pragma omp parallel for if(mic::types::useParallel(inner_ * dim_ * outer_))
+		for (size_t t = 0; t < tasks; t++) {
+			const size_t block = t / parts;
+			const size_t begin = (t % parts) * REDUCTION_BLOCK;
+			const T* ptr = data_ + block * inner_ + begin;
+			const size_t size = std::min(REDUCTION_BLOCK, inner_ - begin);
+			if (pass == 0)
+				partial[t] = pairwiseSum(ptr, size, IdentityTransform());
+			else {
+				SquaredDeviationTransform f = deviation;
+				f.mean = means_[block % dim_];
+				partial[t] = pairwiseSum(ptr, size, f);
+			}//: else
+		}//: for
+
+		// Combine partial sums of every slice.
+		double* out = (pass == 0) ? means_ : variances_;
+		for (size_t k = 0; k < dim_; k++) {
+			double sum = 0;
+			for (size_t o = 0; o < outer_; o++)
+				for (size_t q = 0; q < parts; q++)
+					sum += partial[(o * dim_ + k) * parts + q];
+			out[k] = sum / count;
+		}//: for
+	}//: for
+}
+
+
+} //: namespace types
+} //: namespace mic
+
+#endif /* SRC_TYPES_REDUCTIONS_HPP_ */
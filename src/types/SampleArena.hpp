@@ -0,0 +1,372 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file SampleArena.hpp
+ * \brief Contains declaration (and definition) of a contiguous storage of samples of identical shape.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_SAMPLEARENA_HPP_
+#define SRC_TYPES_SAMPLEARENA_HPP_
+
+#include <vector>
+#include <cstring> // memcpy
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+#include <Eigen/Dense>
+
+#include <types/AlignedMemory.hpp>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Template class storing samples of identical shape in a single, aligned block of memory ("slab").
+ * Labels are stored in a flat array, so that adding N samples results in O(log N) allocations instead of 2N.
+ * Every sample starts at an address aligned to DEFAULT_MEMORY_ALIGNMENT, what enables sequential, prefetch-friendly access in epoch loops.
+ * Samples are accessed through lightweight views (raw pointers or Eigen maps), there is no per-sample object.
+ * @tparam T Template parameter defining the type of a single element of the sample payload (float, double, uint8_t etc.).
+ * @tparam LabelType Template parameter defining the sample label type.
+ * \author tkornuta
+ */
+template<typename T, typename LabelType>
+class SampleArena {
+public:
+	static_assert(std::is_arithmetic<T>::value, "SampleArena can store only payloads of arithmetic types");
+
+	/// Type of the (column-major) matrix view of a single sample.
+	typedef Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Aligned> MatrixMap;
+
+	/// Type of the constant (column-major) matrix view of a single sample.
+	typedef Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Aligned> ConstMatrixMap;
+
+	/// Type of the view of a batch of consecutive samples - a matrix with one (flattened) sample per column, columns being sampleStride() apart.
+	typedef Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Aligned, Eigen::OuterStride<> > BatchMap;
+
+	/// Type of the constant view of a batch of consecutive samples.
+	typedef Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Aligned, Eigen::OuterStride<> > ConstBatchMap;
+
+	/*!
+	 * Constructor. Sets the shape of samples and optionally reserves memory.
+	 * @param sample_dims_ Dimensions of a single sample. For 2D samples the matrix view has (dims[0] x dims[1]) size, otherwise (size x 1).
+	 * @param capacity_ Number of samples for which memory will be reserved (DEFAULT=0).
+	 */
+	SampleArena(std::vector<size_t> sample_dims_ = {1}, size_t capacity_ = 0) :
+		sample_dims(sample_dims_),
+		samples(0),
+		max_samples(0),
+		slab_ptr(nullptr)
+	{
+		// Calculate sample size.
+		sample_size = 1;
+		for (auto ith_dimension : sample_dims) {
+			// Every dimension must be greater than 0!
+			assert(ith_dimension > 0);
+			sample_size *= ith_dimension;
+		}//: for
+		// Every sample starts at the aligned address.
+		sample_stride = alignedSize(sample_size * sizeof(T)) / sizeof(T);
+
+		// Reserve memory.
+		reserve(capacity_);
+	}
+
+	/*!
+	 * Copying constructor - copies the shape, labels and the used part of the slab.
+	 * @param arena_ The original arena to be copied.
+	 */
+	SampleArena(const SampleArena<T, LabelType>& arena_) :
+		sample_dims(arena_.sample_dims),
+		sample_size(arena_.sample_size),
+		sample_stride(arena_.sample_stride),
+		samples(0),
+		max_samples(0),
+		slab_ptr(nullptr),
+		sample_labels(arena_.sample_labels)
+	{
+		reserve(arena_.samples);
+		if (arena_.samples > 0)
+			memcpy(slab_ptr, arena_.slab_ptr, sizeof(T) * sample_stride * arena_.samples);
+		samples = arena_.samples;
+	}
+
+	/*!
+	 * Move constructor - takes over the slab of the original arena.
+	 * @param arena_ The original arena (left empty).
+	 */
+	SampleArena(SampleArena<T, LabelType>&& arena_) :
+		sample_dims(std::move(arena_.sample_dims)),
+		sample_size(arena_.sample_size),
+		sample_stride(arena_.sample_stride),
+		samples(arena_.samples),
+		max_samples(arena_.max_samples),
+		slab_ptr(arena_.slab_ptr),
+		sample_labels(std::move(arena_.sample_labels))
+	{
+		arena_.samples = 0;
+		arena_.max_samples = 0;
+		arena_.slab_ptr = nullptr;
+	}
+
+	/*!
+	 * Assignment operator - copies the shape, labels and the used part of the slab.
+	 * @param arena_ The original arena to be copied.
+	 * @return An exact copy of the input arena.
+	 */
+	SampleArena<T, LabelType>& operator=(const SampleArena<T, LabelType>& arena_) {
+		if (this == &arena_)
+			return *this;
+		// Release the old slab.
+		alignedFree(slab_ptr);
+		slab_ptr = nullptr;
+		samples = 0;
+		max_samples = 0;
+		// Copy shape.
+		sample_dims = arena_.sample_dims;
+		sample_size = arena_.sample_size;
+		sample_stride = arena_.sample_stride;
+		// Copy data.
+		reserve(arena_.samples);
+		if (arena_.samples > 0)
+			memcpy(slab_ptr, arena_.slab_ptr, sizeof(T) * sample_stride * arena_.samples);
+		samples = arena_.samples;
+		sample_labels = arena_.sample_labels;
+		return *this;
+	}
+
+	/*!
+	 * Destructor. Frees the slab.
+	 */
+	virtual ~SampleArena() {
+		alignedFree(slab_ptr);
+	}
+
+	/*!
+	 * Reserves memory for a given number of samples. Does nothing if the current capacity is sufficient.
+	 * @param capacity_ Number of samples.
+	 */
+	void reserve(size_t capacity_) {
+		if (capacity_ <= max_samples)
+			return;
+		// Allocate a new slab.
+		T* new_slab_ptr = (T*)alignedMalloc(sizeof(T) * sample_stride * capacity_);
+		// Copy the old samples.
+		if (slab_ptr != nullptr) {
+			memcpy(new_slab_ptr, slab_ptr, sizeof(T) * sample_stride * samples);
+			alignedFree(slab_ptr);
+		}//: if
+		slab_ptr = new_slab_ptr;
+		max_samples = capacity_;
+		sample_labels.reserve(capacity_);
+	}
+
+	/*!
+	 * Adds a new sample to the arena and returns pointer to its (uninitialized) payload, so that it can be decoded straight into the slab.
+	 * Note: the returned pointer is valid until the next reallocation (i.e. add() exceeding the capacity or reserve()).
+	 * @param label_ Sample label.
+	 * @return Pointer to the payload of the added sample.
+	 */
+	T* add(const LabelType& label_) {
+		// Grow geometrically.
+		if (samples == max_samples)
+			reserve((max_samples > 0) ? 2 * max_samples : 16);
+		// Add label.
+		sample_labels.push_back(label_);
+		return slab_ptr + sample_stride * (samples++);
+	}
+
+	/*!
+	 * Adds a new sample to the arena - copies the payload.
+	 * @param data_ Pointer to the payload (sampleSize() elements).
+	 * @param label_ Sample label.
+	 * @return Pointer to the payload of the added sample.
+	 */
+	T* add(const T* data_, const LabelType& label_) {
+		T* dst_ptr = add(label_);
+		memcpy(dst_ptr, data_, sizeof(T) * sample_size);
+		return dst_ptr;
+	}
+
+	/*!
+	 * Returns pointer to the payload of a given sample.
+	 * @param index_ Index of the sample.
+	 * @return Pointer to the sample data.
+	 */
+	inline T* data(size_t index_) {
+		return slab_ptr + sample_stride * index_;
+	}
+
+	/*!
+	 * Returns pointer to the payload of a given sample.
+	 * @param index_ Index of the sample.
+	 * @return Pointer to the sample data.
+	 */
+	inline const T* data(size_t index_) const {
+		return slab_ptr + sample_stride * index_;
+	}
+
+	/*!
+	 * Returns a matrix view of a given sample (no copy is made).
+	 * If index is out of arena range throws an "std::out_of_range" exception.
+	 * @param index_ Index of the sample.
+	 * @return Eigen map pointing to the sample payload.
+	 */
+	MatrixMap matrix(size_t index_) {
+		if (index_ >= samples)
+			throw std::out_of_range("Sample index out of range!");
+		return MatrixMap(data(index_), rows(), cols());
+	}
+
+	/*!
+	 * Returns a constant matrix view of a given sample (no copy is made).
+	 * If index is out of arena range throws an "std::out_of_range" exception.
+	 * @param index_ Index of the sample.
+	 * @return Eigen map pointing to the sample payload.
+	 */
+	ConstMatrixMap matrix(size_t index_) const {
+		if (index_ >= samples)
+			throw std::out_of_range("Sample index out of range!");
+		return ConstMatrixMap(data(index_), rows(), cols());
+	}
+
+	/*!
+	 * Returns a view of a batch of consecutive samples - a (sampleSize() x size_) matrix, one flattened sample per column, pointing directly to the slab (no copy is made).
+	 * If the batch exceeds the arena range throws an "std::out_of_range" exception.
+	 * @param begin_ Index of the first sample.
+	 * @param size_ Number of samples.
+	 * @return Eigen map pointing to the payloads of samples.
+	 */
+	BatchMap batch(size_t begin_, size_t size_) {
+		if ((begin_ > samples) || (size_ > samples - begin_))
+			throw std::out_of_range("Batch out of arena range!");
+		return BatchMap(slab_ptr + sample_stride * begin_, sample_size, size_, Eigen::OuterStride<>(sample_stride));
+	}
+
+	/*!
+	 * Returns a constant view of a batch of consecutive samples (no copy is made).
+	 * If the batch exceeds the arena range throws an "std::out_of_range" exception.
+	 * @param begin_ Index of the first sample.
+	 * @param size_ Number of samples.
+	 * @return Eigen map pointing to the payloads of samples.
+	 */
+	ConstBatchMap batch(size_t begin_, size_t size_) const {
+		if ((begin_ > samples) || (size_ > samples - begin_))
+			throw std::out_of_range("Batch out of arena range!");
+		return ConstBatchMap(slab_ptr + sample_stride * begin_, sample_size, size_, Eigen::OuterStride<>(sample_stride));
+	}
+
+	/*!
+	 * Returns label of a given sample.
+	 * @param index_ Index of the sample.
+	 * @return Sample label.
+	 */
+	inline LabelType& label(size_t index_) {
+		return sample_labels[index_];
+	}
+
+	/*!
+	 * Returns label of a given sample.
+	 * @param index_ Index of the sample.
+	 * @return Sample label.
+	 */
+	inline const LabelType& label(size_t index_) const {
+		return sample_labels[index_];
+	}
+
+	/// Returns the (flat) array of labels.
+	std::vector<LabelType> & labels() {
+		return sample_labels;
+	}
+
+	/// Returns pointer to the beginning of the slab.
+	T* slab() {
+		return slab_ptr;
+	}
+
+	/// Returns the number of stored samples.
+	size_t size() const {
+		return samples;
+	}
+
+	/// Returns the number of samples that fit into the currently allocated slab.
+	size_t capacity() const {
+		return max_samples;
+	}
+
+	/// Returns the dimensions of a single sample.
+	const std::vector<size_t>& dims() const {
+		return sample_dims;
+	}
+
+	/// Returns the number of elements of a single sample.
+	size_t sampleSize() const {
+		return sample_size;
+	}
+
+	/// Returns the distance (in elements) between the beginnings of two consecutive samples.
+	size_t sampleStride() const {
+		return sample_stride;
+	}
+
+	/// Returns the number of rows of the matrix view.
+	size_t rows() const {
+		return (sample_dims.size() == 2) ? sample_dims[0] : sample_size;
+	}
+
+	/// Returns the number of columns of the matrix view.
+	size_t cols() const {
+		return (sample_dims.size() == 2) ? sample_dims[1] : 1;
+	}
+
+	/*!
+	 * Removes all samples. Keeps the allocated slab.
+	 */
+	void clear() {
+		samples = 0;
+		sample_labels.clear();
+	}
+
+protected:
+	/// Dimensions of a single sample.
+	std::vector<size_t> sample_dims;
+
+	/// Number of elements of a single sample.
+	size_t sample_size;
+
+	/// Distance (in elements) between two consecutive samples - sample size rounded up to the alignment.
+	size_t sample_stride;
+
+	/// Number of stored samples.
+	size_t samples;
+
+	/// Number of samples that fit into the allocated slab.
+	size_t max_samples;
+
+	/// The slab - a single, aligned block of memory storing payloads of all samples.
+	T* slab_ptr;
+
+	/// Stores labels.
+	std::vector<LabelType> sample_labels;
+};
+
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_SAMPLEARENA_HPP_ */
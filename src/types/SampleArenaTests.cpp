@@ -0,0 +1,163 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: SampleArenaTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+// Redefine word "public" so every class field/method will be accessible for tests.
+#define private public
+#include <types/SampleArena.hpp>
+
+/*!
+ * Tests whether consecutive samples are aligned and stored in a single slab.
+ */
+TEST(SampleArena, AlignedSamples3x5) {
+	const size_t N = 3;
+	const size_t M = 5;
+
+	mic::types::SampleArena<float, unsigned int> arena({N, M}, 4);
+	for (size_t s = 0; s < 4; s++)
+		arena.add(s);
+
+	ASSERT_EQ(arena.size(), 4);
+	ASSERT_EQ(arena.sampleSize(), N*M);
+	ASSERT_GE(arena.sampleStride(), N*M);
+	for (size_t s = 0; s < 4; s++) {
+		ASSERT_EQ((size_t)arena.data(s) % mic::types::DEFAULT_MEMORY_ALIGNMENT, 0);
+		ASSERT_EQ(arena.data(s), arena.slab() + s * arena.sampleStride());
+		ASSERT_EQ(arena.label(s), s);
+	}//: for
+}
+
+
+/*!
+ * Tests whether samples and labels are preserved when the slab grows.
+ */
+TEST(SampleArena, GrowthPreservesData) {
+	const size_t N = 2;
+	const size_t M = 3;
+
+	mic::types::SampleArena<float, unsigned int> arena({N, M});
+	float buffer[N*M];
+	for (size_t s = 0; s < 100; s++) {
+		for (size_t i = 0; i < N*M; i++)
+			buffer[i] = s * 10 + i;
+		arena.add(buffer, s % 10);
+	}//: for
+
+	ASSERT_EQ(arena.size(), 100);
+	ASSERT_GE(arena.capacity(), 100);
+	for (size_t s = 0; s < 100; s++) {
+		ASSERT_EQ(arena.label(s), s % 10);
+		for (size_t i = 0; i < N*M; i++)
+			ASSERT_EQ(arena.data(s)[i], s * 10 + i);
+	}//: for
+}
+
+
+/*!
+ * Tests the matrix view - it must point to the slab (no copy) and be column-major.
+ */
+TEST(SampleArena, MatrixView2x3) {
+	const size_t N = 2;
+	const size_t M = 3;
+
+	mic::types::SampleArena<double, char> arena({N, M});
+	double* data = arena.add('a');
+	for (size_t i = 0; i < N*M; i++)
+		data[i] = i;
+
+	auto view = arena.matrix(0);
+	ASSERT_EQ(view.rows(), N);
+	ASSERT_EQ(view.cols(), M);
+	ASSERT_EQ(view.data(), data);
+	ASSERT_EQ(view(1,0), 1);
+	ASSERT_EQ(view(0,2), 4);
+
+	// Modify through the view.
+	view(1,2) = 42;
+	ASSERT_EQ(data[5], 42);
+
+	ASSERT_THROW(arena.matrix(1), std::out_of_range);
+}
+
+
+/*!
+ * Tests copying and moving of arenas.
+ */
+TEST(SampleArena, CopyAndMove) {
+	mic::types::SampleArena<uint8_t, unsigned int> arena({28, 28});
+	for (size_t s = 0; s < 10; s++) {
+		uint8_t* data = arena.add(s);
+		for (size_t i = 0; i < 28*28; i++)
+			data[i] = (uint8_t)(s + i);
+	}//: for
+
+	mic::types::SampleArena<uint8_t, unsigned int> copied(arena);
+	ASSERT_EQ(copied.size(), 10);
+	ASSERT_NE(copied.slab(), arena.slab());
+	for (size_t s = 0; s < 10; s++) {
+		ASSERT_EQ(copied.label(s), s);
+		ASSERT_EQ(memcmp(copied.data(s), arena.data(s), 28*28), 0);
+	}//: for
+
+	uint8_t* slab = arena.slab();
+	mic::types::SampleArena<uint8_t, unsigned int> moved(std::move(arena));
+	ASSERT_EQ(moved.slab(), slab);
+	ASSERT_EQ(moved.size(), 10);
+	ASSERT_EQ(arena.size(), 0);
+	ASSERT_EQ(arena.slab(), nullptr);
+}
+
+
+/*!
+ * Tests the batch view - consecutive samples as columns of a matrix pointing to the slab.
+ */
+TEST(SampleArena, BatchView) {
+	mic::types::SampleArena<float, unsigned int> arena({3, 1});
+	for (size_t s = 0; s < 5; s++) {
+		float* data = arena.add(s);
+		for (size_t i = 0; i < 3; i++)
+			data[i] = 10 * s + i;
+	}//: for
+
+	auto batch = arena.batch(1, 3);
+	ASSERT_EQ(batch.rows(), 3);
+	ASSERT_EQ(batch.cols(), 3);
+	ASSERT_EQ(batch.data(), arena.data(1));
+	ASSERT_EQ(batch(2, 0), 12);
+	ASSERT_EQ(batch(0, 2), 30);
+	// Sum of columns - Eigen expressions work directly on the slab.
+	ASSERT_EQ(batch.colwise().sum()(1), 63);
+
+	ASSERT_THROW(arena.batch(3, 3), std::out_of_range);
+	ASSERT_EQ(arena.batch(5, 0).cols(), 0);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -28,10 +28,20 @@
 
 #include <stdio.h>
 #include <vector>
+#include <array>
 #include <random>
 #include <memory> // std::shared_ptr
+#include <utility> // std::move
+#include <algorithm> // std::max
 #include <cstring> // memcpy
 
+#include <types/Parallel.hpp>
+#include <types/RandomFill.hpp>
+#include <types/TensorView.hpp>
+#include <types/TensorExpressions.hpp>
+#include <types/Reductions.hpp>
+#include <types/AlignedMemory.hpp>
+
 #include <boost/serialization/serialization.hpp>
 // include this header to serialize vectors
 #include <boost/serialization/vector.hpp>
@@ -53,6 +63,18 @@ namespace types {
 template<typename T>
 class Matrix;
 
+/*!
+ * \brief Allocator used by tensors of a given type. As default tensors use blocks aligned to the cache line (64 bytes).
+ * In order to plug in a different allocator specialize the structure for a given type.
+ * \author tkornuta
+ * \tparam T Type of elements.
+ */
+template<typename T>
+struct TensorAllocator {
+	/// Type of the allocator.
+	typedef mic::types::AlignedAllocator<T> type;
+};
+
 /*!
  * \brief Template class representing an nD (n-Dimensional) tensor.
  * Tensor is row-major, i.e. first dimension is height (rows), second is width (cols), third is depth (channels) etc.
@@ -60,13 +82,15 @@ class Matrix;
  * \tparam T template parameter denoting data type stored in tensor.
  */
 template<class T>
-class Tensor {
+class Tensor : public mic::types::TensorExpression< Tensor<T> > {
 public:
+	/// Type of elements.
+	typedef T value_type;
 
 	/*!
 	 * Default constructor (empty).
 	 */
-	Tensor() : elements(0), data_ptr(nullptr) {
+	Tensor() : elements(0), data_ptr(nullptr), reserved_elements(0) {
 
 	}
 
@@ -74,31 +98,25 @@ public:
 	 * Constructor - sets the tensor dimension and assigns memory.
 	 * @param dims_ Tensor dimensions - initilizer list ({ }).
 	 */
-	Tensor(std::initializer_list<size_t> dims_) {
-		// Set dimensions.
-		elements = 1;
-		for (auto ith_dimension : dims_) {
-			// Every dimension must be greater than 0!
-			assert(ith_dimension > 0);
-			// Add dimension.
-			dimensions.push_back(ith_dimension);
-			elements *= ith_dimension;
-		}//: for
+	Tensor(std::initializer_list<size_t> dims_) : Tensor(std::vector<size_t>(dims_)) {
 
-		// Allocate memory.
-		data_ptr = new T[elements];
-		// Check whether data was allocated. :]
-		assert(data_ptr != nullptr);
+	}
 
+	/*!
+	 * Constructor - sets the tensor dimension and assigns memory.
+	 * @param dims_ Tensor dimensions ({ }, vector<size_t> etc.).
+	 */
+	Tensor(const std::vector<size_t>& dims_) : Tensor(dims_, UNINITIALIZED) {
 		// Initialize: set all elements to zeros.
 		zeros();
 	}
 
 	/*!
-	 * Constructor - sets the tensor dimension and assigns memory.
+	 * Constructor - sets the tensor dimension and assigns memory, but leaves the elements uninitialized.
+	 * Intended for tensors that will be overwritten anyway - saves the (costly) zeroing of memory.
 	 * @param dims_ Tensor dimensions ({ }, vector<size_t> etc.).
 	 */
-	Tensor(std::vector<size_t> dims_) {
+	Tensor(const std::vector<size_t>& dims_, UninitializedTag) {
 		// Set dimensions.
 		elements = 1;
 		for (auto ith_dimension : dims_) {
@@ -108,33 +126,36 @@ public:
 			dimensions.push_back(ith_dimension);
 			elements *= ith_dimension;
 		}//: for
+		updateStrides();
 
 		// Allocate memory.
-		data_ptr = new T[elements];
-		// Check whether data was allocated. :]
-		assert(data_ptr != nullptr);
-
-		// Initialize: set all elements to zeros.
-		zeros();
+		data_ptr = allocate(elements);
+		reserved_elements = elements;
 	}
 
 	/*!
 	 * Copying constructor - copies the values of the given tensor, including tensor dimensions and data.
 	 * @param t The original tensor to be copied.
 	 */
-	Tensor(const Tensor<T>& t) {
-		// Copy dimensions.
-		elements = t.elements;
-		dimensions.reserve(t.dimensions.size());
-		std::copy(t.dimensions.begin(), t.dimensions.end(),
-				std::back_inserter(dimensions));
-
+	Tensor(const Tensor<T>& t) : elements(t.elements), dimensions(t.dimensions), strides(t.strides), reserved_elements(t.elements) {
 		// Allocate memory.
-		data_ptr = new T[t.elements];
+		data_ptr = allocate(t.elements);
 		// Copy data.
 		memcpy(data_ptr, t.data_ptr, sizeof(T) * elements);
 	}
 
+	/*!
+	 * Moving constructor - takes over the data of the given tensor, which is left empty.
+	 * @param t The original tensor to be moved.
+	 */
+	Tensor(Tensor<T>&& t) noexcept : elements(t.elements), dimensions(std::move(t.dimensions)), strides(std::move(t.strides)), data_ptr(t.data_ptr), reserved_elements(t.reserved_elements) {
+		t.elements = 0;
+		t.data_ptr = nullptr;
+		t.reserved_elements = 0;
+		t.dimensions.clear();
+		t.strides.clear();
+	}
+
 	/*!
 	 * Copying constructor - copies the values of the given 2D matrix.
 	 * @param t The original matrix to be copied.
@@ -144,52 +165,103 @@ public:
 		elements = mat_.cols() * mat_.rows();
 		dimensions.push_back(mat_.cols());
 		dimensions.push_back(mat_.rows());
+		updateStrides();
 
 		// Allocate memory.
-		data_ptr = new T[elements];
+		data_ptr = allocate(elements);
+		reserved_elements = elements;
 		// Copy data.
 		memcpy(data_ptr, mat_.data(), sizeof(T) * elements);
 	}
 
+	/*!
+	 * Constructor evaluating an expression (e.g. a + b * c) - all elements are computed in a single loop.
+	 * @param expr_ Expression.
+	 */
+	template<typename E>
+	Tensor(const mic::types::TensorExpression<E>& expr_) : Tensor(expr_.derived().dims(), UNINITIALIZED) {
+		evaluate(expr_.derived());
+	}
+
 	/*!
 	 * Assign operator - copies the values of the given tensor, including tensor dimensions and data.
 	 * @param t The original tensor to be copied.
 	 */
 	const Tensor<T>& operator=(const Tensor<T>& t) {
-		// Check the dimensions.
-		if (elements != t.elements) {
-			elements = t.elements;
-			// Allocate memory.
-			if (data_ptr != nullptr)
-				delete[] data_ptr;
-			data_ptr = new T[t.elements];
+		if (this == &t)
+			return *this;
+		// Reallocate memory only if the reserved block is too small.
+		if (reserved_elements < t.elements) {
+			deallocate(data_ptr, reserved_elements);
+			data_ptr = allocate(t.elements);
+			reserved_elements = t.elements;
 		}//: if
+		elements = t.elements;
 
 		// Copy dimensions.
-		dimensions.clear();
-		dimensions.reserve(t.dimensions.size());
-		std::copy(t.dimensions.begin(), t.dimensions.end(),
-				std::back_inserter(dimensions));
+		dimensions = t.dimensions;
+		strides = t.strides;
 
 		// Copy data.
 		memcpy(data_ptr, t.data_ptr, sizeof(T) * elements);
 		return *this;
 	}
 
+	/*!
+	 * Move assign operator - takes over the data of the given tensor, which is left empty.
+	 * @param t The original tensor to be moved.
+	 */
+	const Tensor<T>& operator=(Tensor<T>&& t) noexcept {
+		if (this == &t)
+			return *this;
+		// Free own data.
+		deallocate(data_ptr, reserved_elements);
+
+		// Take over the data and dimensions.
+		elements = t.elements;
+		data_ptr = t.data_ptr;
+		reserved_elements = t.reserved_elements;
+		dimensions = std::move(t.dimensions);
+		strides = std::move(t.strides);
+
+		t.elements = 0;
+		t.data_ptr = nullptr;
+		t.reserved_elements = 0;
+		t.dimensions.clear();
+		t.strides.clear();
+		return *this;
+	}
+
+	/*!
+	 * Assign operator evaluating an expression - all elements are computed in a single loop, writing directly into the tensor.
+	 * The expression may refer to the tensor itself (e.g. a = a * b + c).
+	 * @param expr_ Expression.
+	 */
+	template<typename E>
+	const Tensor<T>& operator=(const mic::types::TensorExpression<E>& expr_) {
+		const E& expr = expr_.derived();
+		if (dimensions == expr.dims())
+			evaluate(expr);
+		else
+			*this = Tensor<T>(expr);
+		return *this;
+	}
+
 	/*!
 	 * Destructor. Frees memory (if it was assigned).
 	 */
 	~Tensor() {
 		// Free memory.
-		if (data_ptr)
-			delete[] data_ptr;
+		deallocate(data_ptr, reserved_elements);
 	}
+
 	/*!
 	 * Flattens the tensor - sets dimensions to [ n ].
 	 */
 	void flatten() {
 		dimensions.clear();
 		dimensions.push_back(elements);
+		updateStrides();
 	}
 
 	/*!
@@ -211,12 +283,13 @@ public:
 		dimensions.clear();
 		dimensions.reserve(dims_.size());
 		std::copy(dims_.begin(), dims_.end(), std::back_inserter(dimensions));
+		updateStrides();
 	}
 
 	/*!
 	 * Resizes the tensor - sets new tensor dimensions.
 	 * Analogically to Eigen, the resize() method is a no-operation if the actual matrix size doesn't change.
-	 * Otherwise, i.e. if the total number of elements must change, a new memory block will be allocated and the method will copy as much elements from the old memory block as possible.
+	 * Otherwise, i.e. if the total number of elements must change, the elements are kept in the reserved block (if it is big enough) or a new memory block will be allocated and the method will copy as much elements from the old memory block as possible.
 	 * If you want a conservative variant of resize() which does not change the coefficients, use conservativeResize(),
 	 * If the new block will be bigger than the old one the values of "new elements" will be set to zeros.
 	 * @param dims_ New dimensions.
@@ -234,49 +307,66 @@ public:
 		dimensions.clear();
 		dimensions.reserve(dims_.size());
 		std::copy(dims_.begin(), dims_.end(), std::back_inserter(dimensions));
+		updateStrides();
 
 		// Copy data.
 		if (new_size != elements) {
-			T* old_prt = data_ptr;
-			// Allocate memory.
-			data_ptr = new T[new_size];
-			// Estimate the size of block that must be copied.
+			// Estimate the size of block that must be kept.
 			size_t block_size = (new_size < elements) ? new_size : elements;
-			// Change number of elements.
+			if (new_size > reserved_elements)
+				reallocate(new_size);
+			// Change number of elements and zero the new ones.
 			elements = new_size;
-			// Zero elements.
-			zeros();
-			// Copy data.
-			memcpy(data_ptr, old_prt, sizeof(T) * block_size);
-			// Free the old block.
-			delete[] old_prt;
+			memset(data_ptr + block_size, 0, sizeof(T) * (new_size - block_size));
 		} //: if
 		//: else: do nothing;)
 	}
 
 	/*!
 	 * Applies the function to all tensor elements.
+	 * The function is a template parameter, so lambdas and functors are inlined and the loop can be vectorized.
+	 * @tparam Func Type of the function - any callable T(T).
 	 * @param func The function to be applied. This must be a function with a single argument.
 	 */
-	void elementwiseFunction(T (*func)(T)) {
-#pragma omp parallel for
+	template<typename Func>
+	void elementwiseFunction(Func func) {
+#pragma omp parallel for if(mic::types::useParallel(elements))
 		for (size_t i = 0; i < elements; i++) {
-			data_ptr[i] = (*func)(data_ptr[i]);
+			data_ptr[i] = func(data_ptr[i]);
 		} //: for
 	}
 
+	/*!
+	 * Applies the function to all tensor elements - overload resolving overloaded function names (e.g. std::exp).
+	 * @param func The function to be applied. This must be a function with a single argument.
+	 */
+	void elementwiseFunction(T (*func)(T)) {
+		elementwiseFunction<T (*)(T)>(func);
+	}
+
 	/*!
 	 * Applies the function to all tensor elements. Additionally passes scalar to the function as second argument.
+	 * @tparam Func Type of the function - any callable T(T, T).
 	 * @param func The function to be applied. This must be a function with exactly two arguments.
 	 * @param scalar Scalar passed as second function argument.
 	 */
-	void elementwiseFunctionScalar(T (*func)(T, T), T scalar) {
-#pragma omp parallel for
+	template<typename Func>
+	void elementwiseFunctionScalar(Func func, T scalar) {
+#pragma omp parallel for if(mic::types::useParallel(elements))
 		for (size_t i = 0; i < elements; i++) {
-			data_ptr[i] = (*func)(data_ptr[i], scalar);
+			data_ptr[i] = func(data_ptr[i], scalar);
 		} //: for
 	}
 
+	/*!
+	 * Applies the function to all tensor elements. Additionally passes scalar to the function as second argument - overload resolving overloaded function names.
+	 * @param func The function to be applied. This must be a function with exactly two arguments.
+	 * @param scalar Scalar passed as second function argument.
+	 */
+	void elementwiseFunctionScalar(T (*func)(T, T), T scalar) {
+		elementwiseFunctionScalar<T (*)(T, T)>(func, scalar);
+	}
+
 
 	/*!
 	 * Set values of all matrix elements to random with a normal distribution.
@@ -284,15 +374,7 @@ public:
 	 * @param stddev Variance
 	 */
 	void normRandReal(float mean = 0, float stddev = 1) {
-		// Initialize random number generator with normal distribution.
-		std::random_device rd;
-		std::mt19937 mt(rd());
-		std::normal_distribution<> dist(mean, stddev);
-		// Set value of all elements to random.
-#pragma omp parallel for
-		for (size_t i = 0; i < elements; i++) {
-			data_ptr[i] = dist(mt);
-		}
+		mic::types::fillNormal(data_ptr, elements, (T)mean, (T)stddev);
 	}
 
 	/*!
@@ -302,25 +384,39 @@ public:
 		return data_ptr;
 	}
 
+	/*!
+	 * Returns constant pointer to data.
+	 */
+	const T* data() const {
+		return data_ptr;
+	}
+
 	/*!
 	 * Returns dimensions.
 	 */
-	std::vector<size_t> dims() {
+	const std::vector<size_t>& dims() const {
 		return dimensions;
 	}
 
 	/*!
 	 * Returns k-th dimension.
 	 */
-	size_t dim(size_t k) {
+	size_t dim(size_t k) const {
 		return dimensions[k];
 	}
 
+	/*!
+	 * Returns k-th stride - distance (in elements) between consecutive elements along k-th dimension.
+	 */
+	size_t stride(size_t k) const {
+		return strides[k];
+	}
+
 	/*!
 	 * Returns size - number of elements.
 	 * @return Number of elements.
 	 */
-	size_t size() {
+	size_t size() const {
 		return elements;
 	}
 
@@ -335,7 +431,7 @@ public:
 	 * Sets all element values to one.
 	 */
 	void ones() {
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(elements))
 		for (size_t i = 0; i < elements; i++)
 			data_ptr[i] = 1;
 	}
@@ -344,7 +440,7 @@ public:
 	 * Enumerates - sets values of elements to their indices.
 	 */
 	void enumerate() {
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(elements))
 		for (size_t i = 0; i < elements; i++)
 			data_ptr[i] = i;
 	}
@@ -354,7 +450,7 @@ public:
 	 * @param value_ The value to be set.
 	 */
 	void setValue(T value_) {
-#pragma omp parallel for
+#pragma omp parallel for if(mic::types::useParallel(elements))
 		for (size_t i = 0; i < elements; i++)
 			data_ptr[i] = value_;
 	}
@@ -366,16 +462,7 @@ public:
 	 * @param stddev Variance
 	 */
 	void randn(T mean = 0, T stddev = 1) {
-
-		// Initialize random number generator with normal distribution.
-		std::random_device rd;
-		std::mt19937 mt(rd());
-		std::normal_distribution<T> dist(mean, stddev);
-
-#pragma omp parallel for
-		for (size_t i = 0; i < elements; i++) {
-			data_ptr[i] = (T)dist(mt);
-		}
+		mic::types::fillNormal(data_ptr, elements, mean, stddev);
 	}
 
 	/*!
@@ -385,74 +472,277 @@ public:
 	 * @return Random real value.
 	 */
 	void rand(T min = 0, T max = 1) {
+		mic::types::fillUniform(data_ptr, elements, min, max);
+	}
 
-		// Initialize random number generator with normal distribution.
-		std::random_device rd;
-		std::mt19937 mt(rd());
-		std::uniform_real_distribution<T> dist(min, max);
 
-#pragma omp parallel for
-		for (size_t i = 0; i < elements; i++) {
-			data_ptr[i] = (T)dist(rd);
-		}
+	/*!
+	 * Adds an expression (tensor) to the tensor (elementwise).
+	 * @param expr_ Expression of the same dimensions.
+	 */
+	template<typename E>
+	const Tensor<T>& operator+=(const mic::types::TensorExpression<E>& expr_) {
+		evaluate(*this + expr_);
+		return *this;
 	}
 
+	/*!
+	 * Subtracts an expression (tensor) from the tensor (elementwise).
+	 * @param expr_ Expression of the same dimensions.
+	 */
+	template<typename E>
+	const Tensor<T>& operator-=(const mic::types::TensorExpression<E>& expr_) {
+		evaluate(*this - expr_);
+		return *this;
+	}
 
 	/*!
-	 * Operator returning new tensor being the sum of two tensors.
-	 * @param obj_ The second tensor (on the right side of the +).
-	 * @return New, resulting tensor being the sum.
+	 * Multiplies the tensor by an expression (tensor) elementwise.
+	 * @param expr_ Expression of the same dimensions.
 	 */
-	mic::types::Tensor<T> operator+(mic::types::Tensor<T> obj_) {
-		// Dimensions must match.
-		assert(dims().size() == obj_.dims().size());
-		for (size_t d=1; d<dimensions.size(); d++) {
-			assert(dimensions[d] == obj_.dimensions[d]);
-		}//: for
+	template<typename E>
+	const Tensor<T>& operator*=(const mic::types::TensorExpression<E>& expr_) {
+		evaluate(*this * expr_);
+		return *this;
+	}
 
-		// Create new tensor.
-		mic::types::Tensor<T> new_tensor(dimensions);
-#pragma omp parallel for
-		for (size_t i = 0; i < elements; i++)
-			new_tensor.data_ptr[i] = data_ptr[i] + obj_.data_ptr[i];
+	/*!
+	 * Divides the tensor by an expression (tensor) elementwise.
+	 * @param expr_ Expression of the same dimensions.
+	 */
+	template<typename E>
+	const Tensor<T>& operator/=(const mic::types::TensorExpression<E>& expr_) {
+		evaluate(*this / expr_);
+		return *this;
+	}
 
-		// Return it.
-		return new_tensor;
+	/*!
+	 * Adds a scalar to all elements.
+	 * @param scalar_ Scalar.
+	 */
+	const Tensor<T>& operator+=(T scalar_) {
+		evaluate(*this + scalar_);
+		return *this;
 	}
 
 	/*!
-	 * Operator returning new tensor being the difference of two tensors.
-	 * @param obj_ The second tensor (on the right side of the -).
-	 * @return New, resulting tensor being the tensor difference.
+	 * Subtracts a scalar from all elements.
+	 * @param scalar_ Scalar.
 	 */
-	mic::types::Tensor<T> operator-(mic::types::Tensor<T> obj_) {
-		// Dimensions must match.
-		assert(dims().size() == obj_.dims().size());
-		for (size_t d=1; d<dimensions.size(); d++) {
-			assert(dimensions[d] == obj_.dimensions[d]);
-		}//: for
+	const Tensor<T>& operator-=(T scalar_) {
+		evaluate(*this - scalar_);
+		return *this;
+	}
 
-		// Create new tensor.
-		mic::types::Tensor<T> new_tensor(dimensions);
-#pragma omp parallel for
-		for (size_t i = 0; i < elements; i++)
-			new_tensor.data_ptr[i] = data_ptr[i] - obj_.data_ptr[i];
+	/*!
+	 * Multiplies all elements by a scalar.
+	 * @param scalar_ Scalar.
+	 */
+	const Tensor<T>& operator*=(T scalar_) {
+		evaluate(*this * scalar_);
+		return *this;
+	}
 
-		// Return it.
-		return new_tensor;
+	/*!
+	 * Divides all elements by a scalar.
+	 * @param scalar_ Scalar.
+	 */
+	const Tensor<T>& operator/=(T scalar_) {
+		evaluate(*this / scalar_);
+		return *this;
 	}
 
 	/*!
-	 * Functions sums the tensor elements.
+	 * Sums the tensor elements. Uses pairwise summation of blocks (reduced in parallel) with double precision accumulators, so the result is accurate also for large float tensors and does not depend on the number of threads.
 	 * @return Sum of tensor elements.
 	 */
-	T sum() {
-		T sum = 0;
-		for (size_t i = 0; i < elements; i++)
-			sum += data_ptr[i];
+	T sum() const {
+		return (T)mic::types::reduceSum(data_ptr, elements, IdentityTransform());
+	}
+
+	/*!
+	 * Returns the mean of tensor elements.
+	 */
+	T mean() const {
+		assert(elements > 0);
+		return (T)(mic::types::reduceSum(data_ptr, elements, IdentityTransform()) / elements);
+	}
+
+	/*!
+	 * Returns the (population) variance of tensor elements - computed in two passes (mean, then squared deviations).
+	 */
+	T variance() const {
+		assert(elements > 0);
+		SquaredDeviationTransform f;
+		f.mean = mic::types::reduceSum(data_ptr, elements, IdentityTransform()) / elements;
+		f.means = nullptr;
+		return (T)(mic::types::reduceSum(data_ptr, elements, f) / elements);
+	}
+
+	/*!
+	 * Returns the minimal element.
+	 */
+	T minCoeff() const {
+		assert(elements > 0);
+		return mic::types::reduceMin(data_ptr, elements);
+	}
+
+	/*!
+	 * Returns the maximal element.
+	 */
+	T maxCoeff() const {
+		assert(elements > 0);
+		return mic::types::reduceMax(data_ptr, elements);
+	}
+
+	/*!
+	 * Returns the index of the (first) minimal element.
+	 */
+	size_t argmin() const {
+		assert(elements > 0);
+		return mic::types::reduceArgMin(data_ptr, elements);
+	}
+
+	/*!
+	 * Returns the index of the (first) maximal element.
+	 */
+	size_t argmax() const {
+		assert(elements > 0);
+		return mic::types::reduceArgMax(data_ptr, elements);
+	}
+
+	/*!
+	 * Returns the L1 norm - sum of absolute values of elements.
+	 */
+	T l1Norm() const {
+		return (T)mic::types::reduceSum(data_ptr, elements, AbsTransform());
+	}
+
+	/*!
+	 * Returns the L2 (Euclidean) norm - square root of the sum of squares of elements.
+	 */
+	T l2Norm() const {
+		return (T)std::sqrt(mic::types::reduceSum(data_ptr, elements, SquareTransform()));
+	}
+
+	/*!
+	 * Sums the tensor elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed (or a tensor of size {1} when the reduced tensor was 1D).
+	 */
+	Tensor<T> sum(size_t axis_) const {
+		return reducedTensor(axis_, axisSums(axis_, IdentityTransform()), 1.0, false);
+	}
+
+	/*!
+	 * Computes means of elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed.
+	 */
+	Tensor<T> mean(size_t axis_) const {
+		return reducedTensor(axis_, axisSums(axis_, IdentityTransform()), 1.0 / dimensions[axis_], false);
+	}
+
+	/*!
+	 * Computes (population) variances of elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed.
+	 */
+	Tensor<T> variance(size_t axis_) const {
+		std::vector<double> means = axisSums(axis_, IdentityTransform());
+		for (size_t i = 0; i < means.size(); i++)
+			means[i] /= dimensions[axis_];
+		SquaredDeviationTransform f;
+		f.mean = 0;
+		f.means = means.data();
+		return reducedTensor(axis_, axisSums(axis_, f), 1.0 / dimensions[axis_], false);
+	}
+
+	/*!
+	 * Computes L1 norms of elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed.
+	 */
+	Tensor<T> l1Norm(size_t axis_) const {
+		return reducedTensor(axis_, axisSums(axis_, AbsTransform()), 1.0, false);
+	}
+
+	/*!
+	 * Computes L2 norms of elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed.
+	 */
+	Tensor<T> l2Norm(size_t axis_) const {
+		return reducedTensor(axis_, axisSums(axis_, SquareTransform()), 1.0, true);
+	}
+
+	/*!
+	 * Finds minimal elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed.
+	 */
+	Tensor<T> minCoeff(size_t axis_) const {
+		size_t inner, dim, outer;
+		axisExtents(axis_, inner, dim, outer);
+		Tensor<T> result(reducedDimensions(axis_), UNINITIALIZED);
+		mic::types::reduceExtremumAxis<T, false>(data_ptr, inner, dim, outer, result.data_ptr, nullptr);
+		return result;
+	}
+
+	/*!
+	 * Finds maximal elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Tensor with the axis removed.
+	 */
+	Tensor<T> maxCoeff(size_t axis_) const {
+		size_t inner, dim, outer;
+		axisExtents(axis_, inner, dim, outer);
+		Tensor<T> result(reducedDimensions(axis_), UNINITIALIZED);
+		mic::types::reduceExtremumAxis<T, true>(data_ptr, inner, dim, outer, result.data_ptr, nullptr);
+		return result;
+	}
+
+	/*!
+	 * Finds positions of (first) minimal elements along a given axis.
+	 * @param axis_ Reduced dimension.
+	 * @return Vector of positions (coordinates along the axis), ordered as elements of tensor with the axis removed.
+	 */
+	std::vector<size_t> argmin(size_t axis_) const {
+		size_t inner, dim, outer;
+		axisExtents(axis_, inner, dim, outer);
+		std::vector<T> values(inner * outer);
+		std::vector<size_t> positions(inner * outer);
+		mic::types::reduceExtremumAxis<T, false>(data_ptr, inner, dim, outer, values.data(), positions.data());
+		return positions;
+	}
+
+	/*!
+	 * Finds positions of (first) maximal elements along a given axis (e.g. predicted classes of a batch of outputs).
+	 * @param axis_ Reduced dimension.
+	 * @return Vector of positions (coordinates along the axis), ordered as elements of tensor with the axis removed.
+	 */
+	std::vector<size_t> argmax(size_t axis_) const {
+		size_t inner, dim, outer;
+		axisExtents(axis_, inner, dim, outer);
+		std::vector<T> values(inner * outer);
+		std::vector<size_t> positions(inner * outer);
+		mic::types::reduceExtremumAxis<T, true>(data_ptr, inner, dim, outer, values.data(), positions.data());
+		return positions;
+	}
 
-		// Return the sum.
-		return sum;
+	/*!
+	 * Computes means and (population) variances of slices along a given axis - e.g. per-channel statistics used for normalization of images (CIFAR, STL) stored as [height x width x channels].
+	 * @param axis_ Axis of slices (e.g. channels).
+	 * @param means_ Output vector of means (resized to the size of the axis).
+	 * @param variances_ Output vector of variances (resized to the size of the axis).
+	 */
+	void sliceMeanVariance(size_t axis_, std::vector<T>& means_, std::vector<T>& variances_) const {
+		size_t inner, dim, outer;
+		axisExtents(axis_, inner, dim, outer);
+		std::vector<double> means(dim), variances(dim);
+		mic::types::reduceSliceMeanVariance(data_ptr, inner, dim, outer, means.data(), variances.data());
+		means_.assign(means.begin(), means.end());
+		variances_.assign(variances.begin(), variances.end());
 	}
 
 	/*!
@@ -489,7 +779,7 @@ public:
 	 * @param coordinates_ nD vector of element coordinates ({ }, vector<size_t> etc.).
 	 * @return The value of the element.
 	 */
-	inline T& operator()(std::vector<size_t> coordinates_) {
+	inline T& operator()(const std::vector<size_t>& coordinates_) {
 		return data_ptr[getIndex(coordinates_)];
 	}
 
@@ -507,179 +797,174 @@ public:
 	 * @param coordinates_ nD vector of element coordinates ({ }, vector<size_t> etc.).
 	 * @return The value of the element.
 	 */
-	inline const T& operator()(std::vector<size_t> coordinates_) const {
-		return (T) data_ptr[getIndex(coordinates_)];
+	inline const T& operator()(const std::vector<size_t>& coordinates_) const {
+		return data_ptr[getIndex(coordinates_)];
+	}
+
+	/*!
+	 * Operator used for setting the value of a given element of nD tensor - coordinates passed as separate arguments (t(i,j,k,l)), so the index is computed without any allocations.
+	 * @param i0_ Coordinate in 0th dimension.
+	 * @param i1_ Coordinate in 1st dimension.
+	 * @param is_ Coordinates in the remaining dimensions.
+	 * @return The value of the element.
+	 */
+	template<typename... Indices>
+	inline T& operator()(size_t i0_, size_t i1_, Indices... is_) {
+		assert(dimensions.size() == 2 + sizeof...(Indices));
+		return data_ptr[i0_ + stridedOffset(1, i1_, is_...)];
+	}
+
+	/*!
+	 * Operator returning the value of a given element of nD tensor - coordinates passed as separate arguments (t(i,j,k,l)).
+	 * @param i0_ Coordinate in 0th dimension.
+	 * @param i1_ Coordinate in 1st dimension.
+	 * @param is_ Coordinates in the remaining dimensions.
+	 * @return The value of the element.
+	 */
+	template<typename... Indices>
+	inline const T& operator()(size_t i0_, size_t i1_, Indices... is_) const {
+		assert(dimensions.size() == 2 + sizeof...(Indices));
+		return data_ptr[i0_ + stridedOffset(1, i1_, is_...)];
+	}
+
+	/*!
+	 * Operator used for setting the value of a given element of nD tensor.
+	 * @param coordinates_ Array of element coordinates.
+	 * @return The value of the element.
+	 */
+	template<size_t N>
+	inline T& operator()(const std::array<size_t, N>& coordinates_) {
+		return data_ptr[getIndex(coordinates_)];
+	}
+
+	/*!
+	 * Operator returning the value of a given element of nD tensor.
+	 * @param coordinates_ Array of element coordinates.
+	 * @return The value of the element.
+	 */
+	template<size_t N>
+	inline const T& operator()(const std::array<size_t, N>& coordinates_) const {
+		return data_ptr[getIndex(coordinates_)];
 	}
 
 	/*!
-	 * Returns the index of an element in nD matrix.
-	 * For dimensions higher than 3 it uses recursive function.
+	 * Returns the index of an element in nD matrix - a sum of coordinates multiplied by (cached) strides.
 	 * @param coordinates_ nD vector of element coordinates ({ }, vector<size_t> etc.).
 	 * @return Index of the element.
 	 */
-	inline size_t getIndex(std::vector<size_t> coordinates_) {
+	inline size_t getIndex(const std::vector<size_t>& coordinates_) const {
 		// Dimensions must match!
-		assert(dims().size() == coordinates_.size());
-		// Do the magic - iterate through all dimensions in order to compute the index.
-		// 1 - x
-		// 2 - y*width + x
-		// 3 - z*height*width + y*width + x = (z*height +y)*width + x
-		// 4 - v*depth*height*width + z*height*width + y*width + x = (v*d +z)(h +y)*w +x
-		// ...
+		assert(dimensions.size() == coordinates_.size());
+		size_t index = coordinates_[0];
+		for (size_t d = 1; d < coordinates_.size(); d++)
+			index += coordinates_[d] * strides[d];
+		return index;
+	}
 
-		// But first: solve the simple 1d-2d-3d cases.
-		switch (coordinates_.size()) {
-		case 1:
-			return coordinates_[0];
-		case 2:
-			return coordinates_[1] * dimensions[0] + coordinates_[0];
-		case 3:
-			return (coordinates_[2] * dimensions[1] + coordinates_[1]) * dimensions[0] + coordinates_[0];
-		default:
-			return recursiveIndex(0, coordinates_);
-		}		//: switch
+	/*!
+	 * Returns the index of an element in nD matrix - a sum of coordinates multiplied by (cached) strides.
+	 * @param coordinates_ Array of element coordinates.
+	 * @return Index of the element.
+	 */
+	template<size_t N>
+	inline size_t getIndex(const std::array<size_t, N>& coordinates_) const {
+		// Dimensions must match!
+		assert(dimensions.size() == N);
+		size_t index = coordinates_[0];
+		for (size_t d = 1; d < N; d++)
+			index += coordinates_[d] * strides[d];
+		return index;
 	}
 
 
+	/*!
+	 * Returns a (non-owning) view of the whole tensor - blocks, slices, transposes etc. of the view do not copy data.
+	 * @return View of the tensor.
+	 */
+	mic::types::TensorView<T> view() {
+		return mic::types::TensorView<T>(*this);
+	}
+
 	/*!
 	 * Returns the (sub)tensor, a new tensor with data being a subtraction from the original tensor taking into account the ranges given as pairs (lower, higher).
-	 * For dimensions higher than 3 it uses recursive block copy.
-	 * @param lower_ Ranges given as pairs (lower, higher) e <0,size-1> for each dimension. If given range consists of a single value, then it is treated as (lower=higher).
+	 * The data is copied by materialization of a block view, i.e. by memcpy of the longest contiguous rows. In order to avoid the copy use view().block().
+	 * @param ranges_ Ranges given as pairs (lower, higher) e <0,size-1> for each dimension. If given range consists of a single value, then it is treated as (lower=higher).
 	 * @return The created subtensor
 	 */
-	Tensor<T> block(std::vector< std::vector<size_t> > ranges_) {
-		// All dimensions (tensor and lower and higher) must be equal!
-		assert(dimensions.size() == ranges_.size());
+	Tensor<T> block(const std::vector< std::vector<size_t> >& ranges_) {
+		return view().block(ranges_).materialize();
+	}
 
-		// Set dimensions.
-		std::vector<size_t> new_dims;
-		for (size_t i=0; i < ranges_.size(); i++) {
-			// Every range must be given.
-			assert((ranges_[i].size() >0) && (ranges_[i].size() < 3));
-			// Add second range - just duble the first one.
-			if (ranges_[i].size() == 1)
-				ranges_[i].push_back(ranges_[i][0]);
-			// Calculate the dimension.
-			size_t ith_dimension = ranges_[i][1] - ranges_[i][0] +1;
-			// Every dimension must be greater than 0!
-			assert(ranges_[i][0] >= 0);
-			assert(ranges_[i][1] < dimensions[i]);
-			assert(ith_dimension > 0);
-			// Add dimension.
-			new_dims.push_back(ith_dimension);
-		}//: for
-		// Create tensor of a required size.
-		mic::types::Tensor<T> new_tensor(new_dims);
-
-		// Do the magic.
-		// Get block by block and copy it in the right places.
-		// But first: solve the simple 1d-2d-3d cases.
-		switch (new_dims.size()) {
-		case 1: {
-			// Copy data from lower to higher.
-			memcpy(new_tensor.data_ptr, (data_ptr + ranges_[0][0]), new_dims[0]* sizeof(T));
-			break;
-			}
-		case 2: {
-			// Iterate through blocks.
-			for (size_t i=ranges_[1][0], j=0; i<=ranges_[1][1]; i++, j++) {
-				// Copy data from lower to higher.
-				memcpy(new_tensor.data_ptr + j* new_dims[0], (data_ptr + i * dimensions[0] + ranges_[0][0]), new_dims[0]* sizeof(T));
-			}//: for
-			break;
-			}
-		case 3: {
-			// Iterate through blocks.
-			for (size_t i2=ranges_[2][0], j2=0; i2<=ranges_[2][1]; i2++, j2++) {
-				for (size_t i1=ranges_[1][0], j1=0; i1<=ranges_[1][1]; i1++, j1++) {
-					// Copy data from lower to higher.
-					memcpy(new_tensor.data_ptr + (j2* new_dims[1] + j1)* new_dims[0], (data_ptr + (i2 * dimensions[1] + i1) * dimensions[0] + ranges_[0][0]), new_dims[0]* sizeof(T));
-					}//: for
-				}//: for
-			break;
-			}
-		default:
-			// Vector of indices - empty for now, will be filled by recursive block copy.
-			std::vector<size_t> is;
-			std::vector<size_t> js;
-			// Recursively copy block by block - starting from 1st dimension, as 0th is treated as the size of block.
-			recursiveBlockCopy(1, ranges_, is, js, new_dims, new_tensor.data_ptr);
-		}//: switch
-
-		return new_tensor;
-	}
-
-	/*!
-	 * Concatenates two tensors - attaches the tensor passed as argument "to the back".
-	 * Note: both tensors must have exactly the same dimensions except the 0th dimension.
+	/*!
+	 * Returns the number of elements for which memory is reserved.
+	 * @return Capacity (in elements).
+	 */
+	size_t capacity() const {
+		return reserved_elements;
+	}
+
+	/*!
+	 * Reserves memory for a given number of elements - subsequent concatenations (or resizes) that fit in the reserved block do not reallocate.
+	 * @param elements_ Number of elements.
+	 */
+	void reserve(size_t elements_) {
+		if (elements_ > reserved_elements)
+			reallocate(elements_);
+	}
+
+	/*!
+	 * Frees the reserved memory that is not used.
+	 */
+	void shrinkToFit() {
+		if (reserved_elements > elements)
+			reallocate(elements);
+	}
+
+	/*!
+	 * Concatenates two tensors - attaches the tensor passed as argument "to the back", i.e. along the last (the slowest changing) dimension.
+	 * The attached tensor must have exactly the same dimensions except the last one - or one dimension less, i.e. be a single "slice" (e.g. a sample).
+	 * An empty tensor simply takes the dimensions of the attached one.
+	 * Memory grows geometrically, hence attaching N tensors one by one costs O(N) copies in total.
 	 * @param obj_ Tensor to be attached.
 	 */
 	void concatenate(const Tensor& obj_) {
-		// All dimensions (except 0th) must be equal!
-		assert(dimensions.size() == obj_.dimensions.size());
-		for (size_t d=1; d<dimensions.size(); d++) {
-			assert(dimensions[d] == obj_.dimensions[d]);
-		}//: for
-
-		// Copy data.
-		T* old_prt = data_ptr;
-		// Allocate a new block of memory.
-		data_ptr = new T[elements + obj_.elements];
+		// Make room - grow geometrically.
+		growFor(obj_.elements);
 
 		// Copy data.
-		memcpy(data_ptr, old_prt, sizeof(T) * elements);
 		memcpy(data_ptr + elements, obj_.data_ptr, sizeof(T) * obj_.elements);
+		appendDimensions(obj_);
+	}
 
-		// Free the old block.
-		delete[] old_prt;
-
-		// Adjust the dimensions.
-		dimensions[0] += obj_.dimensions[0];
-		elements += obj_.elements;
+	/*!
+	 * Concatenates two tensors - analogue of concatenate(const Tensor&) that takes over the data if this tensor is empty.
+	 * @param obj_ Tensor to be attached.
+	 */
+	void concatenate(Tensor&& obj_) {
+		if (elements == 0)
+			*this = std::move(obj_);
+		else
+			concatenate(static_cast<const Tensor&>(obj_));
 	}
 
 	/*!
-	 * Concatenates a set of tensors - attaches the tensors passed as argument "to the back" of a given tensor.
-	 * Note: both tensors must have exactly the same dimensions except the 0th dimension.
-	 * @param objs_ A list of tensors to be attached.
+	 * Concatenates a set of tensors - attaches the tensors passed as argument "to the back" of a given tensor, reallocating memory at most once.
+	 * Note: all tensors must have exactly the same dimensions except the last one.
+	 * @param tensors_ A list of tensors to be attached.
 	 */
-	void concatenate(std::vector<mic::types::Tensor<T> > tensors_) {
-		// All dimensions (except 0th) of all tensors must be equal!
+	void concatenate(const std::vector<mic::types::Tensor<T> >& tensors_) {
 		size_t new_block_size = 0;
-		size_t added_zero_dim = 0;
-		for (auto tensor: tensors_) {
-			assert(dimensions.size() == tensor.dimensions.size());
-			for (size_t d=1; d<dimensions.size(); d++) {
-				assert(dimensions[d] == tensor.dimensions[d]);
-			}//: for
+		for (const auto& tensor: tensors_)
 			new_block_size += tensor.elements;
-			added_zero_dim += tensor.dimensions[0];
-		}//: for
+		growFor(new_block_size);
 
-		// Ptr to old data.
-		T* old_prt = data_ptr;
-
-		// Allocate a new block of memory.
-		data_ptr = new T[elements + new_block_size];
-		// Copy old data.
-		memcpy(data_ptr, old_prt, sizeof(T) * elements);
-		// Free the old block.
-		delete[] old_prt;
-
-		// Copy the rest.
-		size_t block_end = elements;
-		for (auto tensor: tensors_) {
-			memcpy(data_ptr + block_end, tensor.data_ptr, sizeof(T) * tensor.elements);
-			block_end += tensor.elements;
+		// Copy the tensors one by one.
+		for (const auto& tensor: tensors_) {
+			memcpy(data_ptr + elements, tensor.data_ptr, sizeof(T) * tensor.elements);
+			appendDimensions(tensor);
 		}//: for
-
-		// Adjust the dimensions.
-		dimensions[0] += added_zero_dim;
-		elements += new_block_size;
 	}
 
-
-
 private:
 	/*!
 	 * Number of elements.
@@ -691,119 +976,195 @@ private:
 	 */
 	std::vector<size_t> dimensions;
 
+	/*!
+	 * Strides - distances (in elements) between consecutive elements along every dimension.
+	 */
+	std::vector<size_t> strides;
+
 	/*!
 	 * Table of elements of data types.
 	 */
 	T* data_ptr;
 
 	/*!
-	 * Recursive method computing the index of element in nD matrix.
-	 * @param dim_ Dimension considered at the moment.
-	 * @param coordinates_ nD vector of coordinates.
-	 * @return Index of the element.
+	 * Number of elements for which memory is reserved (capacity).
 	 */
-	size_t recursiveIndex(size_t dim_, std::vector<size_t> coordinates_) {
-		if (dim_ == coordinates_.size() - 1)
-			return coordinates_[dim_];
-		else
-			return recursiveIndex(dim_ + 1, coordinates_) * dimensions[dim_] + coordinates_[dim_];
-	}
-
-
-	/*!
-	 * A recursive function copying the blocks of data from source (current) tensor to the new one.
-	 * 0th dimension (of the new tensor) is treated as the size of a block.
-	 * The function calls itself (recursively) in order to generate a vector of indices used subsequently for calculation of positions in both source and target data tables.
-	 * It uses two helper functions (also recursive) for computation of those positions.
-	 * WARNING: Tensor dimensions must be > 1!
-	 * @param dim_ The currently analyzed dimension of tensor.
-	 * @param ranges_ nD vector of pairs of ranges.
-	 * @param is_ nD vector of indices in the source tensor.
-	 * @param js_ nD vector of indices in the new/target tensor.
-	 * @param new_dims_ nD vector of dimensions of the new tensor.
-	 * @param tgt_data_ptr_ Pointer to the memory block of the new tensor.
-	 */
-	void recursiveBlockCopy (size_t dim_, std::vector< std::vector<size_t> > ranges_, std::vector<size_t> is_, std::vector<size_t> js_, std::vector<size_t> new_dims_, T* tgt_data_ptr_) {
-		// Check dimensions!
-		assert(new_dims_.size()>1);
-		//
-		if (dim_ == new_dims_.size()){
-			// Calculate destination index.
-			size_t tgt_index = recursiveCalculateTargetIndex(0, js_, new_dims_);
-			//std::cout << "recursive tgt_index = " << tgt_index << std::endl;
-			// Calculate destination index.
-			size_t src_index = recursiveCalculateSourceIndex(0, is_, ranges_[0][0]);
-			//std::cout << "recursive src_index = " << src_index << std::endl;
-			// Copy data from source to target.
-			memcpy(tgt_data_ptr_ + tgt_index, (data_ptr + src_index), new_dims_[0]* sizeof(T));
-			return;
-		}
-		// For all ranges collect indices list for source and targets.
-		for (size_t i=ranges_[dim_][0], j=0; i<=ranges_[dim_][1]; i++, j++) {
-			// Add indices to lists.
-			is_.push_back(i);
-			js_.push_back(j);
-			// Better call Saul! Otherwise call block copy ;)
-			recursiveBlockCopy(dim_ + 1, ranges_, is_, js_, new_dims_, tgt_data_ptr_);
-			// Remove recently added indices from lists. ;)
-			is_.pop_back();
-			js_.pop_back();
-		}
-	}
+	size_t reserved_elements;
 
 	/*!
-	 * A recursive function responsible for the calculation of position (index) in target (i.e. new) data table.
-	 * @param dim_ The currently analyzed dimension of tensor.
-	 * @param js_ nD vector of indices in the new/target tensor.
-	 * @param dims_ nD vector of dimensions of the (new) tensor.
-	 * @return Index in target (new) data table.
+	 * Moves the elements to a newly allocated block of a given capacity.
+	 * @param capacity_ Capacity (must not be smaller than the number of elements).
 	 */
-	size_t recursiveCalculateTargetIndex(size_t dim_, std::vector<size_t> js_, std::vector<size_t> dims_) {
-		if (dim_ == js_.size()) {
-			//std::cout << " returning js_["<< dim_-1 <<"] = " << js_[dim_-1] << std::endl;
-			return js_[dim_-1];
-		} else if (dim_ == 0) {
-			//std::cout << "calling recursiveCalculateTargetIndex(dim_+1 ("<< dim_ + 1 << "), js_, dims_)"<< std::endl;
-			size_t tmp = recursiveCalculateTargetIndex(dim_ + 1, js_, dims_);
-			size_t tmp2 = tmp * dims_[dim_];
-			//std::cout <<  " returning tmp2 ("<< tmp2 <<") = tmp (" << tmp << ") * dims_[dim_ ("<< dim_<< ")] ("<< dims_[dim_] << ") "<< std::endl;
-			return tmp2;
-		} else {
+	void reallocate(size_t capacity_) {
+		T* new_ptr = allocate(capacity_);
+		if (elements > 0)
+			memcpy(new_ptr, data_ptr, sizeof(T) * elements);
+		deallocate(data_ptr, reserved_elements);
+		data_ptr = new_ptr;
+		reserved_elements = capacity_;
+	}
 
-			//std::cout << "calling recursiveCalculateTargetIndex(dim_+1 ("<< dim_ + 1 << "), js_, dims_)"<< std::endl;
-			size_t tmp = recursiveCalculateTargetIndex(dim_ + 1, js_, dims_);
-			size_t tmp2 = tmp * dims_[dim_] + js_[dim_-1];
-			//std::cout <<  " returning tmp2 ("<< tmp2 <<") = tmp (" << tmp << ") * dims_[dim_ ("<< dim_<< ")] ("<< dims_[dim_] << ") + js_[dim_-1] ("<< js_[dim_-1]  << ") "<< std::endl;
-			return tmp2;
-		}//: else
+	/*!
+	 * Makes sure there is room for a given number of additional elements - the capacity is (at least) doubled.
+	 * @param added_ Number of added elements.
+	 */
+	void growFor(size_t added_) {
+		size_t required = elements + added_;
+		if (required > reserved_elements)
+			reallocate(std::max(required, 2 * reserved_elements));
 	}
 
 	/*!
-	 * A recursive function responsible for the calculation of position (index) in source (i.e. this) data table.
-	 * @param dim_ The currently analyzed dimension of tensor.
-	 * @param is_ nD vector of indices in the source tensor.
-	 * @param offset_ Offset added aat the end(always const = range[0][0]).
-	 * @return Index in source (this) data table.
+	 * Adjusts the dimensions after appending a tensor "to the back" (along the last dimension).
+	 * @param obj_ Attached tensor.
 	 */
-	size_t recursiveCalculateSourceIndex(size_t dim_, std::vector<size_t> is_, size_t offset_) {
-		if (dim_ == is_.size()) {
-			//std::cout << " returning is_["<< dim_-1 <<"] = " << is_[dim_-1] << std::endl;
-			return is_[dim_-1];
-		} else if (dim_ == 0) {
-			//std::cout << "calling recursiveCalculateSourceIndex(dim_+1 ("<< dim_ + 1 << "), is_, dimensions)"<< std::endl;
-			size_t tmp = recursiveCalculateSourceIndex(dim_ + 1, is_, offset_);
-			size_t tmp2 = tmp * dimensions[dim_] + offset_;
-			//std::cout <<  " returning tmp2 ("<< tmp2 <<") = tmp (" << tmp << ") * dimensions[dim_ ("<< dim_<< ")] ("<< dimensions[dim_] << ") + offset (" << offset_ <<")"<< std::endl;
-			return tmp2;
+	void appendDimensions(const Tensor& obj_) {
+		if (dimensions.empty()) {
+			// Empty tensor - take the dimensions of the attached one.
+			dimensions = obj_.dimensions;
+			strides = obj_.strides;
+		} else if (obj_.dimensions.size() + 1 == dimensions.size()) {
+			// A single slice.
+			for (size_t d=0; d<obj_.dimensions.size(); d++) {
+				assert(dimensions[d] == obj_.dimensions[d]);
+			}//: for
+			dimensions.back() += 1;
 		} else {
-			//std::cout << "calling recursiveCalculateSourceIndex(dim_+1 ("<< dim_ + 1 << "), is_, dims_)"<< std::endl;
-			size_t tmp = recursiveCalculateSourceIndex(dim_ + 1, is_, offset_);
-			size_t tmp2 = tmp * dimensions[dim_] + is_[dim_-1];
-			//std::cout <<  " returning tmp2 ("<< tmp2 <<") = tmp (" << tmp << ") * dimensions[dim_ ("<< dim_<< ")] ("<< dimensions[dim_] << ") + is_[dim_-1] ("<< is_[dim_-1]  << ") "<< std::endl;
-			return tmp2;
+			// All dimensions (except the last one) must be equal!
+			assert(dimensions.size() == obj_.dimensions.size());
+			for (size_t d=0; d<dimensions.size()-1; d++) {
+				assert(dimensions[d] == obj_.dimensions[d]);
+			}//: for
+			dimensions.back() += obj_.dimensions.back();
 		}//: else
+		elements += obj_.elements;
+	}
+
+	/*!
+	 * Evaluates an expression of the same size as the tensor - a single (parallel) loop writing the results directly into the tensor data.
+	 * @param expr_ Expression.
+	 */
+	template<typename E>
+	void evaluate(const E& expr_) {
+		assert(expr_.size() == elements);
+#pragma omp parallel for if(mic::types::useParallel(elements))
+		for (size_t i = 0; i < elements; i++)
+			data_ptr[i] = expr_(i);
 	}
 
+	/*!
+	 * Computes extents of data as seen by reductions along a given axis - [inner x dim x outer] (inner being the fastest changing).
+	 * @param axis_ Reduced dimension.
+	 * @param inner_ Product of dimensions preceding the axis.
+	 * @param dim_ Size of the axis.
+	 * @param outer_ Product of dimensions following the axis.
+	 */
+	void axisExtents(size_t axis_, size_t& inner_, size_t& dim_, size_t& outer_) const {
+		assert(axis_ < dimensions.size());
+		inner_ = strides[axis_];
+		dim_ = dimensions[axis_];
+		outer_ = (inner_ * dim_ > 0) ? elements / (inner_ * dim_) : 0;
+	}
+
+	/*!
+	 * Returns dimensions with a given axis removed ({1} if no dimension remains).
+	 * @param axis_ Removed dimension.
+	 */
+	std::vector<size_t> reducedDimensions(size_t axis_) const {
+		std::vector<size_t> dims(dimensions);
+		dims.erase(dims.begin() + axis_);
+		if (dims.empty())
+			dims.push_back(1);
+		return dims;
+	}
+
+	/*!
+	 * Sums (transformed) elements along a given axis, with double precision.
+	 * @tparam F Type of the transformation.
+	 * @param axis_ Reduced dimension.
+	 * @param f_ Transformation applied to elements.
+	 * @return Sums, ordered as elements of tensor with the axis removed.
+	 */
+	template<typename F>
+	std::vector<double> axisSums(size_t axis_, F f_) const {
+		size_t inner, dim, outer;
+		axisExtents(axis_, inner, dim, outer);
+		std::vector<double> sums(inner * outer);
+		mic::types::reduceSumAxis(data_ptr, inner, dim, outer, f_, sums.data());
+		return sums;
+	}
+
+	/*!
+	 * Creates tensor with a given axis removed out of (scaled) sums.
+	 * @param axis_ Reduced dimension.
+	 * @param sums_ Sums.
+	 * @param scale_ Scale by which every sum is multiplied.
+	 * @param root_ Flag indicating whether the square root of every (scaled) sum should be taken.
+	 * @return Tensor.
+	 */
+	Tensor<T> reducedTensor(size_t axis_, const std::vector<double>& sums_, double scale_, bool root_) const {
+		Tensor<T> result(reducedDimensions(axis_), UNINITIALIZED);
+		for (size_t i = 0; i < sums_.size(); i++)
+			result.data_ptr[i] = (T)(root_ ? std::sqrt(sums_[i] * scale_) : sums_[i] * scale_);
+		return result;
+	}
+
+	/*!
+	 * Allocates a block of memory for a given number of elements with the tensor allocator.
+	 * @param n_ Number of elements.
+	 * @return Pointer to the block.
+	 */
+	static T* allocate(size_t n_) {
+		typename TensorAllocator<T>::type allocator;
+		return allocator.allocate(n_);
+	}
+
+	/*!
+	 * Frees the block of memory allocated with allocate().
+	 * @param ptr_ Pointer to the block (can be nullptr).
+	 * @param n_ Number of elements.
+	 */
+	static void deallocate(T* ptr_, size_t n_) {
+		if (ptr_ == nullptr)
+			return;
+		typename TensorAllocator<T>::type allocator;
+		allocator.deallocate(ptr_, n_);
+	}
+
+	/*!
+	 * Computes strides on the basis of dimensions - must be called every time the dimensions change.
+	 * 0th dimension is the fastest changing one, hence strides[0] = 1, strides[1] = dims[0], strides[2] = dims[0]*dims[1] etc.
+	 */
+	void updateStrides() {
+		strides.resize(dimensions.size());
+		size_t stride = 1;
+		for (size_t d = 0; d < dimensions.size(); d++) {
+			strides[d] = stride;
+			stride *= dimensions[d];
+		}//: for
+	}
+
+	/*!
+	 * Terminates the recursion of stridedOffset().
+	 * @return Zero.
+	 */
+	inline size_t stridedOffset(size_t) const {
+		return 0;
+	}
+
+	/*!
+	 * Computes the offset of coordinates starting from a given dimension - unrolled at compile time into a sequence of multiply-adds.
+	 * @param dim_ Dimension of the first coordinate.
+	 * @param i_ The first coordinate.
+	 * @param is_ The remaining coordinates.
+	 * @return Offset.
+	 */
+	template<typename... Indices>
+	inline size_t stridedOffset(size_t dim_, size_t i_, Indices... is_) const {
+		return i_ * strides[dim_] + stridedOffset(dim_ + 1, is_...);
+	}
+
+
 	// Friend class - required for using boost serialization.
     friend class boost::serialization::access;
 
@@ -826,12 +1187,14 @@ private:
      */
      template<class Archive>
      void load(Archive & ar, const unsigned int version) {
+		// Free memory.
+		deallocate(data_ptr, reserved_elements);
 		ar & elements;
 		ar & dimensions;
+		updateStrides();
 		// Allocate memory.
-		if (data_ptr != nullptr)
-			delete[] data_ptr;
-		data_ptr = new T[elements];
+		data_ptr = allocate(elements);
+		reserved_elements = elements;
 		ar & boost::serialization::make_array<T>(data_ptr, elements);
      }
 
@@ -0,0 +1,415 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TensorExpressions.hpp
+ * \brief Contains expression templates - lazy, elementwise operations on tensors that are evaluated in a single loop.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_TENSOREXPRESSIONS_HPP_
+#define SRC_TYPES_TENSOREXPRESSIONS_HPP_
+
+#include <vector>
+#include <memory> // std::shared_ptr
+#include <stdexcept>
+#include <functional> // std::plus, std::minus etc.
+
+namespace mic {
+namespace types {
+
+// Forward declaration of a class Tensor.
+template<class T>
+class Tensor;
+
+/*!
+ * \brief Base class of all tensor expressions (Curiously Recurring Template Pattern).
+ * An expression is not evaluated when created - it only stores its operands.
+ * The elements are computed one by one (by operator()(index)) when the expression is assigned to a tensor, so a chain of operations like a + b * c - 2 becomes a single loop without temporary tensors.
+ * Note: expressions keep references to named tensors, so they must not outlive them. Temporary tensors (e.g. returned by functions) are moved into the expression (see TensorTemporary).
+ * \author tkornuta
+ * \tparam E Type of the derived expression.
+ */
+template<typename E>
+class TensorExpression {
+public:
+	/*!
+	 * Returns reference to the derived expression.
+	 */
+	const E& derived() const {
+		return static_cast<const E&>(*this);
+	}
+};
+
+
+/*!
+ * \brief Expression holding a temporary tensor (e.g. makeTensor() + b) - the tensor is moved into a shared block, so the expression (and its copies) can safely outlive the statement that created it.
+ * \author tkornuta
+ * \tparam T Type of tensor elements.
+ */
+template<typename T>
+class TensorTemporary : public TensorExpression< TensorTemporary<T> > {
+public:
+	/// Type of elements.
+	typedef T value_type;
+
+	/*!
+	 * Constructor - takes over the tensor.
+	 * @param tensor_ Temporary tensor.
+	 */
+	explicit TensorTemporary(mic::types::Tensor<T>&& tensor_) : tensor(std::make_shared< const mic::types::Tensor<T> >(std::move(tensor_))) { }
+
+	/*!
+	 * Returns the element with a given index.
+	 * @param index_ Index.
+	 * @return Value of the element.
+	 */
+	inline value_type operator()(size_t index_) const {
+		return (*tensor)(index_);
+	}
+
+	/// Returns number of elements.
+	size_t size() const {
+		return tensor->size();
+	}
+
+	/// Returns dimensions.
+	const std::vector<size_t>& dims() const {
+		return tensor->dims();
+	}
+
+private:
+	/// Tensor shared by copies of the expression.
+	std::shared_ptr< const mic::types::Tensor<T> > tensor;
+};
+
+
+/*!
+ * \brief Trait defining how an operand is stored in an expression - tensors are stored by reference, (light) expressions by value.
+ * \tparam E Type of the operand.
+ */
+template<typename E>
+struct ExpressionOperand {
+	/// Type of the stored operand.
+	typedef const E type;
+};
+
+/*!
+ * \brief Trait defining how an operand is stored in an expression - specialization for tensors.
+ * \tparam T Type of tensor elements.
+ */
+template<typename T>
+struct ExpressionOperand< mic::types::Tensor<T> > {
+	/// Type of the stored operand.
+	typedef const mic::types::Tensor<T>& type;
+};
+
+
+/*!
+ * \brief Expression applying an elementwise operation to elements of two expressions.
+ * \author tkornuta
+ * \tparam Op Type of the operation (functor with two arguments).
+ * \tparam L Type of the left operand.
+ * \tparam R Type of the right operand.
+ */
+template<typename Op, typename L, typename R>
+class BinaryExpression : public TensorExpression< BinaryExpression<Op, L, R> > {
+public:
+	/// Type of elements.
+	typedef typename L::value_type value_type;
+
+	/*!
+	 * Constructor.
+	 * @param lhs_ Left operand.
+	 * @param rhs_ Right operand.
+	 * @param op_ Operation.
+	 */
+	BinaryExpression(const L& lhs_, const R& rhs_, Op op_ = Op()) : lhs(lhs_), rhs(rhs_), op(op_) {
+		// Dimensions must match.
+		if (lhs.dims() != rhs.dims())
+			throw std::invalid_argument("BinaryExpression: dimensions of operands mismatch!");
+	}
+
+	/*!
+	 * Computes the element with a given index.
+	 * @param index_ Index.
+	 * @return Value of the element.
+	 */
+	inline value_type operator()(size_t index_) const {
+		return op(lhs(index_), rhs(index_));
+	}
+
+	/// Returns number of elements.
+	size_t size() const {
+		return lhs.size();
+	}
+
+	/// Returns dimensions.
+	const std::vector<size_t>& dims() const {
+		return lhs.dims();
+	}
+
+private:
+	/// Left operand.
+	typename ExpressionOperand<L>::type lhs;
+
+	/// Right operand.
+	typename ExpressionOperand<R>::type rhs;
+
+	/// Operation.
+	Op op;
+};
+
+
+/*!
+ * \brief Expression applying an elementwise operation to elements of an expression and a scalar.
+ * \author tkornuta
+ * \tparam Op Type of the operation (functor with two arguments).
+ * \tparam E Type of the expression.
+ * \tparam ScalarOnLeft Flag indicating whether the scalar is the left argument of the operation.
+ */
+template<typename Op, typename E, bool ScalarOnLeft>
+class ScalarExpression : public TensorExpression< ScalarExpression<Op, E, ScalarOnLeft> > {
+public:
+	/// Type of elements.
+	typedef typename E::value_type value_type;
+
+	/*!
+	 * Constructor.
+	 * @param expr_ Operand.
+	 * @param scalar_ Scalar.
+	 * @param op_ Operation.
+	 */
+	ScalarExpression(const E& expr_, value_type scalar_, Op op_ = Op()) : expr(expr_), scalar(scalar_), op(op_) { }
+
+	/*!
+	 * Computes the element with a given index.
+	 * @param index_ Index.
+	 * @return Value of the element.
+	 */
+	inline value_type operator()(size_t index_) const {
+		return ScalarOnLeft ? op(scalar, expr(index_)) : op(expr(index_), scalar);
+	}
+
+	/// Returns number of elements.
+	size_t size() const {
+		return expr.size();
+	}
+
+	/// Returns dimensions.
+	const std::vector<size_t>& dims() const {
+		return expr.dims();
+	}
+
+private:
+	/// Operand.
+	typename ExpressionOperand<E>::type expr;
+
+	/// Scalar.
+	value_type scalar;
+
+	/// Operation.
+	Op op;
+};
+
+
+/*!
+ * \brief Expression applying an elementwise operation to elements of an expression.
+ * \author tkornuta
+ * \tparam Op Type of the operation (functor with one argument).
+ * \tparam E Type of the operand.
+ */
+template<typename Op, typename E>
+class UnaryExpression : public TensorExpression< UnaryExpression<Op, E> > {
+public:
+	/// Type of elements.
+	typedef typename E::value_type value_type;
+
+	/*!
+	 * Constructor.
+	 * @param expr_ Operand.
+	 * @param op_ Operation.
+	 */
+	UnaryExpression(const E& expr_, Op op_ = Op()) : expr(expr_), op(op_) { }
+
+	/*!
+	 * Computes the element with a given index.
+	 * @param index_ Index.
+	 * @return Value of the element.
+	 */
+	inline value_type operator()(size_t index_) const {
+		return op(expr(index_));
+	}
+
+	/// Returns number of elements.
+	size_t size() const {
+		return expr.size();
+	}
+
+	/// Returns dimensions.
+	const std::vector<size_t>& dims() const {
+		return expr.dims();
+	}
+
+private:
+	/// Operand.
+	typename ExpressionOperand<E>::type expr;
+
+	/// Operation.
+	Op op;
+};
+
+
+/*!
+ * Macro defining an elementwise operator between two expressions (tensors) - temporary tensors are moved into the expression.
+ * @param OP Operator.
+ * @param FUNCTOR Standard functor implementing the operation.
+ */
+#define MIC_TENSOR_BINARY_OPERATORS(OP, FUNCTOR) \
+template<typename L, typename R> \
+inline BinaryExpression<FUNCTOR<typename L::value_type>, L, R> operator OP(const TensorExpression<L>& lhs_, const TensorExpression<R>& rhs_) { \
+	return BinaryExpression<FUNCTOR<typename L::value_type>, L, R>(lhs_.derived(), rhs_.derived()); \
+} \
+template<typename T, typename R> \
+inline BinaryExpression<FUNCTOR<T>, TensorTemporary<T>, R> operator OP(mic::types::Tensor<T>&& lhs_, const TensorExpression<R>& rhs_) { \
+	return BinaryExpression<FUNCTOR<T>, TensorTemporary<T>, R>(TensorTemporary<T>(std::move(lhs_)), rhs_.derived()); \
+} \
+template<typename L, typename T> \
+inline BinaryExpression<FUNCTOR<typename L::value_type>, L, TensorTemporary<T> > operator OP(const TensorExpression<L>& lhs_, mic::types::Tensor<T>&& rhs_) { \
+	return BinaryExpression<FUNCTOR<typename L::value_type>, L, TensorTemporary<T> >(lhs_.derived(), TensorTemporary<T>(std::move(rhs_))); \
+} \
+template<typename T> \
+inline BinaryExpression<FUNCTOR<T>, TensorTemporary<T>, TensorTemporary<T> > operator OP(mic::types::Tensor<T>&& lhs_, mic::types::Tensor<T>&& rhs_) { \
+	return BinaryExpression<FUNCTOR<T>, TensorTemporary<T>, TensorTemporary<T> >(TensorTemporary<T>(std::move(lhs_)), TensorTemporary<T>(std::move(rhs_))); \
+}
+
+MIC_TENSOR_BINARY_OPERATORS(+, std::plus)
+MIC_TENSOR_BINARY_OPERATORS(-, std::minus)
+MIC_TENSOR_BINARY_OPERATORS(*, std::multiplies)
+MIC_TENSOR_BINARY_OPERATORS(/, std::divides)
+
+#undef MIC_TENSOR_BINARY_OPERATORS
+
+/*!
+ * Operator returning an expression being the elementwise negation of an expression (tensor).
+ */
+template<typename E>
+inline UnaryExpression<std::negate<typename E::value_type>, E> operator-(const TensorExpression<E>& expr_) {
+	return UnaryExpression<std::negate<typename E::value_type>, E>(expr_.derived());
+}
+
+/*!
+ * Operator returning an expression being the elementwise negation of a temporary tensor.
+ */
+template<typename T>
+inline UnaryExpression<std::negate<T>, TensorTemporary<T> > operator-(mic::types::Tensor<T>&& tensor_) {
+	return UnaryExpression<std::negate<T>, TensorTemporary<T> >(TensorTemporary<T>(std::move(tensor_)));
+}
+
+
+/*!
+ * Returns an expression applying a function (lambda, functor) to every element of an expression (tensor).
+ * @tparam Op Type of the function - any callable T(T).
+ * @param expr_ Expression.
+ * @param op_ Function.
+ * @return Expression.
+ */
+template<typename E, typename Op>
+inline UnaryExpression<Op, E> unaryExpr(const TensorExpression<E>& expr_, Op op_) {
+	return UnaryExpression<Op, E>(expr_.derived(), op_);
+}
+
+/*!
+ * Returns an expression applying a function (lambda, functor) to every element of a temporary tensor.
+ */
+template<typename T, typename Op>
+inline UnaryExpression<Op, TensorTemporary<T> > unaryExpr(mic::types::Tensor<T>&& tensor_, Op op_) {
+	return UnaryExpression<Op, TensorTemporary<T> >(TensorTemporary<T>(std::move(tensor_)), op_);
+}
+
+/*!
+ * Returns an expression applying a function (lambda, functor) to pairs of elements of two expressions (tensors).
+ * @tparam Op Type of the function - any callable T(T, T).
+ * @param lhs_ Left expression.
+ * @param rhs_ Right expression.
+ * @param op_ Function.
+ * @return Expression.
+ */
+template<typename L, typename R, typename Op>
+inline BinaryExpression<Op, L, R> binaryExpr(const TensorExpression<L>& lhs_, const TensorExpression<R>& rhs_, Op op_) {
+	return BinaryExpression<Op, L, R>(lhs_.derived(), rhs_.derived(), op_);
+}
+
+/*!
+ * Returns an expression applying a function (lambda, functor) to pairs of elements of a temporary tensor and an expression.
+ */
+template<typename T, typename R, typename Op>
+inline BinaryExpression<Op, TensorTemporary<T>, R> binaryExpr(mic::types::Tensor<T>&& lhs_, const TensorExpression<R>& rhs_, Op op_) {
+	return BinaryExpression<Op, TensorTemporary<T>, R>(TensorTemporary<T>(std::move(lhs_)), rhs_.derived(), op_);
+}
+
+/*!
+ * Returns an expression applying a function (lambda, functor) to pairs of elements of an expression and a temporary tensor.
+ */
+template<typename L, typename T, typename Op>
+inline BinaryExpression<Op, L, TensorTemporary<T> > binaryExpr(const TensorExpression<L>& lhs_, mic::types::Tensor<T>&& rhs_, Op op_) {
+	return BinaryExpression<Op, L, TensorTemporary<T> >(lhs_.derived(), TensorTemporary<T>(std::move(rhs_)), op_);
+}
+
+/*!
+ * Returns an expression applying a function (lambda, functor) to pairs of elements of two temporary tensors.
+ */
+template<typename T, typename Op>
+inline BinaryExpression<Op, TensorTemporary<T>, TensorTemporary<T> > binaryExpr(mic::types::Tensor<T>&& lhs_, mic::types::Tensor<T>&& rhs_, Op op_) {
+	return BinaryExpression<Op, TensorTemporary<T>, TensorTemporary<T> >(TensorTemporary<T>(std::move(lhs_)), TensorTemporary<T>(std::move(rhs_)), op_);
+}
+
+
+/*!
+ * Macro defining operators between an expression and a scalar (in both orders) - temporary tensors are moved into the expression.
+ * @param OP Operator.
+ * @param FUNCTOR Standard functor implementing the operation.
+ */
+#define MIC_TENSOR_SCALAR_OPERATORS(OP, FUNCTOR) \
+template<typename E> \
+inline ScalarExpression<FUNCTOR<typename E::value_type>, E, false> operator OP(const TensorExpression<E>& expr_, typename E::value_type scalar_) { \
+	return ScalarExpression<FUNCTOR<typename E::value_type>, E, false>(expr_.derived(), scalar_); \
+} \
+template<typename E> \
+inline ScalarExpression<FUNCTOR<typename E::value_type>, E, true> operator OP(typename E::value_type scalar_, const TensorExpression<E>& expr_) { \
+	return ScalarExpression<FUNCTOR<typename E::value_type>, E, true>(expr_.derived(), scalar_); \
+} \
+template<typename T> \
+inline ScalarExpression<FUNCTOR<T>, TensorTemporary<T>, false> operator OP(mic::types::Tensor<T>&& tensor_, typename TensorTemporary<T>::value_type scalar_) { \
+	return ScalarExpression<FUNCTOR<T>, TensorTemporary<T>, false>(TensorTemporary<T>(std::move(tensor_)), scalar_); \
+} \
+template<typename T> \
+inline ScalarExpression<FUNCTOR<T>, TensorTemporary<T>, true> operator OP(typename TensorTemporary<T>::value_type scalar_, mic::types::Tensor<T>&& tensor_) { \
+	return ScalarExpression<FUNCTOR<T>, TensorTemporary<T>, true>(TensorTemporary<T>(std::move(tensor_)), scalar_); \
+}
+
+MIC_TENSOR_SCALAR_OPERATORS(+, std::plus)
+MIC_TENSOR_SCALAR_OPERATORS(-, std::minus)
+MIC_TENSOR_SCALAR_OPERATORS(*, std::multiplies)
+MIC_TENSOR_SCALAR_OPERATORS(/, std::divides)
+
+#undef MIC_TENSOR_SCALAR_OPERATORS
+
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_TENSOREXPRESSIONS_HPP_ */
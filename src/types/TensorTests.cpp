@@ -25,6 +25,7 @@
 #include <gtest/gtest.h>
 
 #include <fstream>
+#include <limits>
 // Include headers that implement a archive in simple text format
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
@@ -132,6 +133,418 @@ TEST(Tensor, Serialization) {
 
 }
 
+/*!
+ * Tests whether parallel and serial sums are equal.
+ */
+TEST(Tensor, SumParallel) {
+	mic::types::Tensor<double> nm({100, 50, 3});
+	nm.enumerate();
+	const double expected = (double)nm.size() * (nm.size() - 1) / 2;
+
+	// Force serial execution.
+	mic::types::setParallelThreshold(nm.size() + 1);
+	ASSERT_EQ(nm.sum(), expected);
+
+	// Force parallel execution.
+	mic::types::setParallelThreshold(0);
+	ASSERT_EQ(nm.sum(), expected);
+
+	mic::types::setParallelThreshold(mic::types::DEFAULT_PARALLEL_THRESHOLD);
+}
+
+/*!
+ * Tests precision of sums of large float tensors and full reductions.
+ */
+TEST(Tensor, ReductionsPrecision) {
+	// 2^24 + 4 elements - a naive float accumulator stops at 2^24.
+	mic::types::Tensor<float> ones({(1 << 24) + 4});
+	ones.setValue(1.0f);
+	ASSERT_EQ(ones.sum(), (float)((1 << 24) + 4));
+	ASSERT_EQ(ones.mean(), 1.0f);
+	ASSERT_EQ(ones.variance(), 0.0f);
+	// The same along axes - both contiguous and strided.
+	mic::types::Tensor<float> columns = ones;
+	columns.resize({(1 << 24) + 4, 1});
+	ASSERT_EQ(columns.sum(0)(0), (float)((1 << 24) + 4));
+	mic::types::Tensor<float> rows({2, (1 << 24) + 4});
+	rows.setValue(1.0f);
+	mic::types::Tensor<float> row_sums = rows.sum(1);
+	ASSERT_EQ(row_sums(0), (float)((1 << 24) + 4));
+	ASSERT_EQ(row_sums(1), (float)((1 << 24) + 4));
+
+	mic::types::Tensor<float> t({3, 4});
+	t.enumerate();
+	t(7) = -20;
+	ASSERT_EQ(t.minCoeff(), -20);
+	ASSERT_EQ(t.maxCoeff(), 11);
+	ASSERT_EQ(t.argmin(), 7);
+	ASSERT_EQ(t.argmax(), 11);
+	// Extrema of NaNs cannot be found - the index is clamped to 0.
+	mic::types::Tensor<float> nans({5});
+	nans.setValue(std::numeric_limits<float>::quiet_NaN());
+	ASSERT_EQ(nans.argmin(), 0);
+	ASSERT_EQ(nans.argmax(), 0);
+	ASSERT_FLOAT_EQ(t.l1Norm(), 66 - 7 + 20);
+	mic::types::Tensor<float> v({2});
+	v(0) = 3;
+	v(1) = -4;
+	ASSERT_FLOAT_EQ(v.l2Norm(), 5);
+}
+
+/*!
+ * Tests reductions along axes and per-channel statistics - serial and parallel.
+ */
+TEST(Tensor, ReductionsAxis) {
+	mic::types::Tensor<double> t({3, 4, 5});
+	t.enumerate();
+
+	for (size_t threshold : {t.size() + 1, (size_t)0}) {
+		mic::types::setParallelThreshold(threshold);
+
+		// Reduce 1st dimension: element (i,k) = sum_j (i + 3j + 12k).
+		mic::types::Tensor<double> s = t.sum(1);
+		ASSERT_EQ(s.dims(), std::vector<size_t>({3, 5}));
+		for (size_t i = 0; i < 3; i++)
+			for (size_t k = 0; k < 5; k++)
+				ASSERT_EQ(s(i, k), 4 * i + 18 + 48 * k);
+
+		// Reduce 0th dimension (contiguous).
+		mic::types::Tensor<double> m = t.mean(0);
+		ASSERT_EQ(m.dims(), std::vector<size_t>({4, 5}));
+		ASSERT_EQ(m(2, 3), 1 + 6 + 36);
+		// Variance of (0, 12, 24, 36, 48).
+		ASSERT_DOUBLE_EQ(t.variance(2)(1, 1), 288);
+
+		ASSERT_EQ(t.maxCoeff(2)(2, 3), 59);
+		ASSERT_EQ(t.minCoeff(2)(2, 3), 11);
+		std::vector<size_t> am = t.argmax(1);
+		ASSERT_EQ(am.size(), 15u);
+		for (size_t i = 0; i < am.size(); i++)
+			ASSERT_EQ(am[i], 3u);
+		ASSERT_DOUBLE_EQ(t.l2Norm(0)(0, 0), sqrt(0 + 1 + 4));
+
+		// Per-channel statistics of [2 x 2 x 3] "image".
+		mic::types::Tensor<double> img({2, 2, 3});
+		img.enumerate();
+		std::vector<double> means, variances;
+		img.sliceMeanVariance(2, means, variances);
+		ASSERT_EQ(means, std::vector<double>({1.5, 5.5, 9.5}));
+		ASSERT_EQ(variances, std::vector<double>({1.25, 1.25, 1.25}));
+	}//: for
+
+	mic::types::setParallelThreshold(mic::types::DEFAULT_PARALLEL_THRESHOLD);
+}
+
+/*!
+ * Tests whether random fills are reproducible for a given seed, independently of parallel/serial execution.
+ */
+TEST(Tensor, RandnReproducible) {
+	mic::types::Tensor<float> serial({101, 33, 3});
+	mic::types::Tensor<float> parallel({101, 33, 3});
+
+	// Force serial execution.
+	mic::types::setParallelThreshold(serial.size() + 1);
+	mic::types::setRandomSeed(1234);
+	serial.randn();
+
+	// Force parallel execution.
+	mic::types::setParallelThreshold(0);
+	mic::types::setRandomSeed(1234);
+	parallel.randn();
+
+	mic::types::setParallelThreshold(mic::types::DEFAULT_PARALLEL_THRESHOLD);
+
+	double mean = 0;
+	for (size_t i = 0; i < serial.size(); i++) {
+		ASSERT_EQ(serial(i), parallel(i));
+		mean += serial(i);
+	}//: for
+	mean /= serial.size();
+	EXPECT_LE(fabs(mean), 0.05);
+
+	// Next fill must give different values.
+	parallel.randn();
+	ASSERT_NE(serial(0), parallel(0));
+}
+
+/*!
+ * Tests whether uniform random values are in the given range.
+ */
+TEST(Tensor, RandRange) {
+	mic::types::Tensor<double> nm({50, 7});
+	nm.rand(-2, 3);
+	for (size_t i = 0; i < nm.size(); i++) {
+		ASSERT_GE(nm(i), -2);
+		ASSERT_LE(nm(i), 3);
+	}//: for
+}
+
+/*!
+ * Tests whether variadic, array and vector indexing of a 4D tensor are consistent.
+ */
+TEST(Tensor, Indexing4D) {
+	mic::types::Tensor<float> nm({2, 3, 4, 5});
+	nm.enumerate();
+
+	ASSERT_EQ(nm.stride(0), 1);
+	ASSERT_EQ(nm.stride(1), 2);
+	ASSERT_EQ(nm.stride(2), 6);
+	ASSERT_EQ(nm.stride(3), 24);
+
+	const mic::types::Tensor<float>& cnm = nm;
+	size_t index = 0;
+	for (size_t l = 0; l < 5; l++)
+		for (size_t k = 0; k < 4; k++)
+			for (size_t j = 0; j < 3; j++)
+				for (size_t i = 0; i < 2; i++) {
+					ASSERT_EQ(nm(i, j, k, l), index);
+					ASSERT_EQ(nm({i, j, k, l}), index);
+					ASSERT_EQ(cnm(std::array<size_t, 4>{{i, j, k, l}}), index);
+					index++;
+				}//: for
+
+	// Strides follow the changes of dimensions.
+	nm.conservativeResize({6, 20});
+	ASSERT_EQ(nm(1, 2), 13);
+	nm(1, 2) = -1;
+	ASSERT_EQ(nm(13), -1);
+}
+
+/*!
+ * Tests whether blocks (copied and viewed) of a 4D tensor contain the right elements.
+ */
+TEST(Tensor, Block4D) {
+	mic::types::Tensor<float> nm({4, 3, 5, 2});
+	nm.enumerate();
+
+	mic::types::Tensor<float> block = nm.block({{1,2},{0,2},{3},{0,1}});
+	mic::types::TensorView<float> view = nm.view().block({{1,2},{0,2},{3},{0,1}});
+	ASSERT_EQ(block.size(), 12);
+	ASSERT_EQ(view.size(), 12);
+	ASSERT_EQ(block.dim(2), 1);
+	for (size_t l = 0; l < 2; l++)
+		for (size_t j = 0; j < 3; j++)
+			for (size_t i = 0; i < 2; i++) {
+				ASSERT_EQ(block(i, j, 0, l), nm(i+1, j, 3, l));
+				ASSERT_EQ(view(i, j, 0, l), nm(i+1, j, 3, l));
+			}//: for
+
+	// Writing through the view changes the tensor.
+	view(0, 0, 0, 0) = -1;
+	ASSERT_EQ(nm(1, 0, 3, 0), -1);
+}
+
+
+/*!
+ * Tests slices, transposes and broadcasts of views.
+ */
+TEST(Tensor, ViewSliceTransposeBroadcast) {
+	// Image: height x width x channels.
+	mic::types::Tensor<float> image({4, 5, 3});
+	image.enumerate();
+
+	// Channel slice.
+	mic::types::Tensor<float> green = image.view().slice(2, 1).materialize();
+	ASSERT_EQ(green.dims().size(), 2);
+	for (size_t j = 0; j < 5; j++)
+		for (size_t i = 0; i < 4; i++)
+			ASSERT_EQ(green(i, j), image(i, j, 1));
+
+	// Transpose of a crop.
+	mic::types::Tensor<float> transposed = image.view().block({{1,3},{0,4},{2}}).transpose(0, 1).materialize();
+	ASSERT_EQ(transposed.dim(0), 5);
+	ASSERT_EQ(transposed.dim(1), 3);
+	for (size_t j = 0; j < 3; j++)
+		for (size_t i = 0; i < 5; i++)
+			ASSERT_EQ(transposed(i, j, 0), image(j+1, i, 2));
+
+	// Broadcast of a column.
+	mic::types::Tensor<float> column({4, 1});
+	column.enumerate();
+	mic::types::Tensor<float> repeated = column.view().broadcast(1, 6).materialize();
+	ASSERT_EQ(repeated.size(), 24);
+	for (size_t j = 0; j < 6; j++)
+		for (size_t i = 0; i < 4; i++)
+			ASSERT_EQ(repeated(i, j), i);
+}
+
+/*!
+ * Tests whether tensor data is aligned and moving takes over the data without copying.
+ */
+TEST(Tensor, MoveAndAlignment) {
+	mic::types::Tensor<float> nm({3, 7, 5});
+	nm.enumerate();
+	ASSERT_EQ((size_t)nm.data() % mic::types::DEFAULT_MEMORY_ALIGNMENT, 0);
+
+	float* ptr = nm.data();
+	mic::types::Tensor<float> moved(std::move(nm));
+	ASSERT_EQ(moved.data(), ptr);
+	ASSERT_EQ(moved(2, 6, 4), 104);
+	ASSERT_EQ(nm.size(), 0);
+	ASSERT_EQ(nm.data(), nullptr);
+
+	// Move assignment.
+	mic::types::Tensor<float> assigned({2, 2});
+	assigned = std::move(moved);
+	ASSERT_EQ(assigned.data(), ptr);
+	ASSERT_EQ(assigned.dim(1), 7);
+
+	// Uninitialized tensor has the right dimensions and strides.
+	mic::types::Tensor<double> uninitialized({4, 5}, mic::types::UNINITIALIZED);
+	ASSERT_EQ(uninitialized.size(), 20);
+	ASSERT_EQ(uninitialized.stride(1), 4);
+	ASSERT_EQ((size_t)uninitialized.data() % mic::types::DEFAULT_MEMORY_ALIGNMENT, 0);
+}
+
+/*!
+ * Tests concatenation of samples along the last dimension and amortized growth of memory.
+ */
+TEST(Tensor, Concatenate) {
+	mic::types::Tensor<float> sample({2, 3});
+	mic::types::Tensor<float> samples;
+
+	size_t reallocations = 0;
+	for (size_t n = 0; n < 100; n++) {
+		sample.setValue(n);
+		float* ptr = samples.data();
+		samples.concatenate(sample);
+		if (samples.data() != ptr)
+			reallocations++;
+	}//: for
+	ASSERT_EQ(samples.dims().size(), 2);
+	ASSERT_EQ(samples.dim(0), 2);
+	ASSERT_EQ(samples.dim(1), 300);
+	ASSERT_LE(reallocations, 10);
+
+	// Every sample is a block of 6 elements.
+	samples.conservativeResize({2, 3, 100});
+	for (size_t n = 0; n < 100; n++)
+		ASSERT_EQ(samples(1, 2, n), n);
+
+	// Append single slices and a set of tensors.
+	mic::types::Tensor<float> slice({2, 3});
+	slice.setValue(-1);
+	samples.concatenate(slice);
+	samples.concatenate({slice, slice});
+	ASSERT_EQ(samples.dim(2), 103);
+	ASSERT_EQ(samples(0, 0, 102), -1);
+
+	samples.shrinkToFit();
+	ASSERT_EQ(samples.capacity(), samples.size());
+}
+
+/*!
+ * Tests elementwise expressions.
+ */
+TEST(Tensor, Expressions) {
+	mic::types::Tensor<double> a({3, 4});
+	mic::types::Tensor<double> b({3, 4});
+	mic::types::Tensor<double> c({3, 4});
+	a.enumerate();
+	b.setValue(2);
+	c.setValue(0.5);
+
+	mic::types::Tensor<double> r = a + b * c - a / b + 1.0;
+	ASSERT_EQ(r.dims(), a.dims());
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), i + 1.0 - i / 2.0 + 1.0);
+
+	// Scalars on the left and negation.
+	r = 2.0 * a - (-b);
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), 2.0 * i + 2.0);
+
+	// Expression referring to the destination.
+	r = r * c + a;
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), 2.0 * i + 1.0);
+
+	// In-place operations.
+	r -= a;
+	r *= 2.0;
+	r /= b;
+	r += a * c;
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), i + 1.0 + i * 0.5);
+
+	// Assignment of an expression of different dimensions.
+	mic::types::Tensor<double> empty;
+	empty = a - a;
+	ASSERT_EQ(empty.size(), 12);
+	ASSERT_EQ(empty.sum(), 0);
+
+	// Operands of the same size, but different dimensions.
+	mic::types::Tensor<double> d({4, 3});
+	ASSERT_THROW(a + d, std::invalid_argument);
+	ASSERT_THROW(r *= d, std::invalid_argument);
+}
+
+/*!
+ * Returns a tensor of given dimensions filled with a value - a temporary operand of expressions.
+ */
+mic::types::Tensor<double> makeFilledTensor(std::vector<size_t> dims_, double value_) {
+	mic::types::Tensor<double> t(dims_);
+	t.setValue(value_);
+	return t;
+}
+
+/*!
+ * Tests expressions with temporary tensors - stored in variables and evaluated after the temporaries are gone.
+ */
+TEST(Tensor, ExpressionsOfTemporaries) {
+	mic::types::Tensor<double> a({3, 4});
+	a.enumerate();
+
+	auto e1 = makeFilledTensor({3, 4}, 2) * a + 1.0;
+	auto e2 = a - makeFilledTensor({3, 4}, 1);
+	auto e3 = makeFilledTensor({3, 4}, 3) / makeFilledTensor({3, 4}, 2);
+	auto e4 = -makeFilledTensor({3, 4}, 5) + 2.0 * makeFilledTensor({3, 4}, 1);
+	auto e5 = mic::types::unaryExpr(makeFilledTensor({3, 4}, 4), [](double x) { return x * x; });
+	auto e6 = mic::types::binaryExpr(a, makeFilledTensor({3, 4}, 1), [](double x, double y) { return x * y; });
+	// Expressions are copied into the outer ones.
+	auto e7 = (makeFilledTensor({3, 4}, 1) + a) * makeFilledTensor({3, 4}, 2);
+
+	mic::types::Tensor<double> r = e1;
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), 2.0 * i + 1.0);
+	r = e2;
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), i - 1.0);
+	r = e3;
+	ASSERT_EQ(r.sum(), 12 * 1.5);
+	r = e4;
+	ASSERT_EQ(r.sum(), 12 * -3.0);
+	r = e5;
+	ASSERT_EQ(r.sum(), 12 * 16.0);
+	r = e6;
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), i);
+	r = e7;
+	for (size_t i = 0; i < r.size(); i++)
+		ASSERT_EQ(r(i), 2.0 * (i + 1.0));
+
+	ASSERT_THROW(makeFilledTensor({4, 3}, 1) + a, std::invalid_argument);
+}
+
+/*!
+ * Tests elementwise functions and expressions with lambdas.
+ */
+TEST(Tensor, ElementwiseFunctors) {
+	mic::types::Tensor<float> a({2, 5});
+	a.enumerate();
+
+	mic::types::Tensor<float> b = a;
+	b.elementwiseFunction([](float x) { return x * x; });
+	ASSERT_EQ(b(1, 4), 81);
+
+	// Lazy unary and binary expressions fused with arithmetic.
+	mic::types::Tensor<float> r = mic::types::unaryExpr(a, [](float x) { return x > 4 ? x : 0.0f; }) + 1.0f;
+	ASSERT_EQ(r(0), 1);
+	ASSERT_EQ(r(9), 10);
+	r = mic::types::binaryExpr(a, b, [](float x, float y) { return y - x; });
+	ASSERT_EQ(r(3), 6);
+}
+
 /*!
  * Tests im2col.
  */
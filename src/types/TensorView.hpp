@@ -0,0 +1,353 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TensorView.hpp
+ * \brief Contains declaration (and definition) of a non-owning, strided view of tensor data.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_TYPES_TENSORVIEW_HPP_
+#define SRC_TYPES_TENSORVIEW_HPP_
+
+#include <types/AlignedMemory.hpp>
+
+#include <vector>
+#include <cstring> // memcpy
+#include <cassert>
+
+namespace mic {
+namespace types {
+
+// Forward declaration of a class Tensor.
+template<class T>
+class Tensor;
+
+/*!
+ * \brief Template class representing a view of (a part of) tensor data - a pointer to the first element plus dimensions and strides.
+ * Blocks, slices, permutations of dimensions (e.g. transposes) and broadcasts (stride equal to zero) are just new views - nothing is copied.
+ * A dense copy can be created with materialize().
+ * Note: the view is valid as long as the memory of the viewed tensor is not freed nor reallocated.
+ * \author tkornuta
+ * \tparam T template parameter denoting data type stored in tensor.
+ */
+template<class T>
+class TensorView {
+public:
+	/*!
+	 * Default constructor - empty view.
+	 */
+	TensorView() : data_ptr(nullptr), elements(0) { }
+
+	/*!
+	 * Constructor - view of a memory block with given dimensions and strides.
+	 * @param data_ Pointer to the first element.
+	 * @param dims_ Dimensions.
+	 * @param strides_ Strides (in elements) - the same number as dimensions.
+	 */
+	TensorView(T* data_, const std::vector<size_t>& dims_, const std::vector<size_t>& strides_) :
+		data_ptr(data_), dimensions(dims_), strides(strides_)
+	{
+		assert(dimensions.size() == strides.size());
+		countElements();
+	}
+
+	/*!
+	 * Constructor - view of the whole tensor.
+	 * @param tensor_ Viewed tensor.
+	 */
+	TensorView(mic::types::Tensor<T>& tensor_) :
+		data_ptr(tensor_.data()), dimensions(tensor_.dims())
+	{
+		strides.resize(dimensions.size());
+		for (size_t d = 0; d < dimensions.size(); d++)
+			strides[d] = tensor_.stride(d);
+		countElements();
+	}
+
+	/*!
+	 * Returns pointer to the first element.
+	 */
+	T* data() const {
+		return data_ptr;
+	}
+
+	/*!
+	 * Returns dimensions.
+	 */
+	const std::vector<size_t>& dims() const {
+		return dimensions;
+	}
+
+	/*!
+	 * Returns k-th dimension.
+	 */
+	size_t dim(size_t k) const {
+		return dimensions[k];
+	}
+
+	/*!
+	 * Returns k-th stride.
+	 */
+	size_t stride(size_t k) const {
+		return strides[k];
+	}
+
+	/*!
+	 * Returns size - number of elements.
+	 */
+	size_t size() const {
+		return elements;
+	}
+
+	/*!
+	 * Checks whether the view is a contiguous block of memory (with 0th dimension being the fastest changing one).
+	 * @return True if the view is contiguous.
+	 */
+	bool isContiguous() const {
+		size_t stride = 1;
+		for (size_t d = 0; d < dimensions.size(); d++) {
+			if ((dimensions[d] > 1) && (strides[d] != stride))
+				return false;
+			stride *= dimensions[d];
+		}//: for
+		return true;
+	}
+
+	/*!
+	 * Operator returning a given element of the view.
+	 * @param coordinates_ nD vector of element coordinates ({ }, vector<size_t> etc.).
+	 * @return Reference to the element.
+	 */
+	inline T& operator()(const std::vector<size_t>& coordinates_) const {
+		assert(dimensions.size() == coordinates_.size());
+		size_t index = 0;
+		for (size_t d = 0; d < coordinates_.size(); d++)
+			index += coordinates_[d] * strides[d];
+		return data_ptr[index];
+	}
+
+	/*!
+	 * Operator returning a given element of the view - coordinates passed as separate arguments (v(i,j,k)).
+	 * @param i0_ Coordinate in 0th dimension.
+	 * @param is_ Coordinates in the remaining dimensions.
+	 * @return Reference to the element.
+	 */
+	template<typename... Indices>
+	inline T& operator()(size_t i0_, Indices... is_) const {
+		assert(dimensions.size() == 1 + sizeof...(Indices));
+		return data_ptr[stridedOffset(0, i0_, is_...)];
+	}
+
+	/*!
+	 * Returns the view of a block, taking into account the ranges given as pairs (lower, higher) - analogue of Tensor::block() that does not copy data.
+	 * @param ranges_ Ranges given as pairs (lower, higher) e <0,size-1> for each dimension. If given range consists of a single value, then it is treated as (lower=higher).
+	 * @return View of the block.
+	 */
+	TensorView<T> block(const std::vector< std::vector<size_t> >& ranges_) const {
+		assert(dimensions.size() == ranges_.size());
+		TensorView<T> view(*this);
+		for (size_t d = 0; d < ranges_.size(); d++) {
+			// Every range must be given.
+			assert((ranges_[d].size() > 0) && (ranges_[d].size() < 3));
+			size_t lower = ranges_[d][0];
+			size_t higher = ranges_[d].back();
+			assert((lower <= higher) && (higher < dimensions[d]));
+			view.data_ptr += lower * strides[d];
+			view.dimensions[d] = higher - lower + 1;
+		}//: for
+		view.countElements();
+		return view;
+	}
+
+	/*!
+	 * Returns the view of a slice - elements with a given coordinate in a given dimension. The dimension is removed from the view.
+	 * @param dim_ Dimension.
+	 * @param index_ Coordinate in the dimension.
+	 * @return View of the slice.
+	 */
+	TensorView<T> slice(size_t dim_, size_t index_) const {
+		assert((dim_ < dimensions.size()) && (index_ < dimensions[dim_]));
+		TensorView<T> view(*this);
+		view.data_ptr += index_ * strides[dim_];
+		view.dimensions.erase(view.dimensions.begin() + dim_);
+		view.strides.erase(view.strides.begin() + dim_);
+		view.countElements();
+		return view;
+	}
+
+	/*!
+	 * Returns the view with permuted dimensions - i-th dimension of the view is order_[i]-th dimension of this view.
+	 * @param order_ Permutation of dimensions.
+	 * @return Permuted view.
+	 */
+	TensorView<T> permute(const std::vector<size_t>& order_) const {
+		assert(order_.size() == dimensions.size());
+		TensorView<T> view(*this);
+		for (size_t d = 0; d < order_.size(); d++) {
+			assert(order_[d] < dimensions.size());
+			view.dimensions[d] = dimensions[order_[d]];
+			view.strides[d] = strides[order_[d]];
+		}//: for
+		return view;
+	}
+
+	/*!
+	 * Returns the view with two dimensions swapped.
+	 * @param dim1_ First dimension (DEFAULT=0).
+	 * @param dim2_ Second dimension (DEFAULT=1).
+	 * @return Transposed view.
+	 */
+	TensorView<T> transpose(size_t dim1_ = 0, size_t dim2_ = 1) const {
+		TensorView<T> view(*this);
+		std::swap(view.dimensions[dim1_], view.dimensions[dim2_]);
+		std::swap(view.strides[dim1_], view.strides[dim2_]);
+		return view;
+	}
+
+	/*!
+	 * Returns the view with a dimension of size one broadcasted (repeated) to a given size - the stride of the dimension is set to zero.
+	 * @param dim_ Dimension (its size must be equal to one).
+	 * @param size_ New size of the dimension.
+	 * @return Broadcasted view.
+	 */
+	TensorView<T> broadcast(size_t dim_, size_t size_) const {
+		assert((dim_ < dimensions.size()) && (dimensions[dim_] == 1));
+		TensorView<T> view(*this);
+		view.dimensions[dim_] = size_;
+		view.strides[dim_] = 0;
+		view.countElements();
+		return view;
+	}
+
+	/*!
+	 * Copies elements of the view into a dense memory block (0th dimension being the fastest changing one).
+	 * Dimensions that are contiguous in memory are merged first, so the copy is done by memcpy of the longest possible rows.
+	 * @param out_ Pointer to the output block (of size() elements).
+	 */
+	void copyTo(T* out_) const {
+		if (elements == 0)
+			return;
+
+		// Coalesce dimensions - skip the ones of size 1 and merge neighbours that are contiguous.
+		std::vector<size_t> dims, strs;
+		for (size_t d = 0; d < dimensions.size(); d++) {
+			if (dimensions[d] == 1)
+				continue;
+			if (!dims.empty() && (strs.back() * dims.back() == strides[d]))
+				dims.back() *= dimensions[d];
+			else {
+				dims.push_back(dimensions[d]);
+				strs.push_back(strides[d]);
+			}//: else
+		}//: for
+		if (dims.empty()) {
+			out_[0] = data_ptr[0];
+			return;
+		}//: if
+
+		const size_t row = dims[0];
+		const size_t rows = elements / row;
+		// Counter of the "outer" dimensions and the current source offset.
+		std::vector<size_t> counter(dims.size(), 0);
+		size_t offset = 0;
+		for (size_t r = 0; r < rows; r++) {
+			T* out_row = out_ + r * row;
+			if (strs[0] == 1)
+				memcpy(out_row, data_ptr + offset, row * sizeof(T));
+			else {
+				for (size_t i = 0; i < row; i++)
+					out_row[i] = data_ptr[offset + i * strs[0]];
+			}//: else
+
+			// Move to the next row.
+			for (size_t d = 1; d < dims.size(); d++) {
+				offset += strs[d];
+				if (++counter[d] < dims[d])
+					break;
+				offset -= strs[d] * dims[d];
+				counter[d] = 0;
+			}//: for
+		}//: for
+	}
+
+	/*!
+	 * Copies elements of the view into a tensor - the tensor is resized to the dimensions of the view.
+	 * @param out_ Output tensor.
+	 */
+	void materialize(mic::types::Tensor<T>& out_) const {
+		out_.resize(dimensions);
+		copyTo(out_.data());
+	}
+
+	/*!
+	 * Returns a new, dense tensor containing elements of the view.
+	 * @return Tensor.
+	 */
+	mic::types::Tensor<T> materialize() const {
+		mic::types::Tensor<T> tensor(dimensions, UNINITIALIZED);
+		copyTo(tensor.data());
+		return tensor;
+	}
+
+private:
+	/// Pointer to the first element.
+	T* data_ptr;
+
+	/// Dimensions.
+	std::vector<size_t> dimensions;
+
+	/// Strides (in elements) of every dimension.
+	std::vector<size_t> strides;
+
+	/// Number of elements.
+	size_t elements;
+
+	/*!
+	 * Computes the number of elements.
+	 */
+	void countElements() {
+		elements = 1;
+		for (size_t d = 0; d < dimensions.size(); d++)
+			elements *= dimensions[d];
+	}
+
+	/*!
+	 * Terminates the recursion of stridedOffset().
+	 * @return Zero.
+	 */
+	inline size_t stridedOffset(size_t) const {
+		return 0;
+	}
+
+	/*!
+	 * Computes the offset of coordinates starting from a given dimension.
+	 * @param dim_ Dimension of the first coordinate.
+	 * @param i_ The first coordinate.
+	 * @param is_ The remaining coordinates.
+	 * @return Offset.
+	 */
+	template<typename... Indices>
+	inline size_t stridedOffset(size_t dim_, size_t i_, Indices... is_) const {
+		return i_ * strides[dim_] + stridedOffset(dim_ + 1, is_...);
+	}
+};
+
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_TENSORVIEW_HPP_ */
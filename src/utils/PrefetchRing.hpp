@@ -0,0 +1,175 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file PrefetchRing.hpp
+ * \brief Contains a bounded ring of reusable slots passing data (e.g. batches) from producer threads to consumer threads.
+ * \author tkornuta
+ * \date Oct 16, 2026
+ */
+
+#ifndef SRC_UTILS_PREFETCHRING_HPP_
+#define SRC_UTILS_PREFETCHRING_HPP_
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace mic {
+namespace utils {
+
+/*!
+ * \brief Bounded ring of preallocated slots, used for passing prepared data (e.g. batches) from producers (background threads) to consumers.
+ * A producer acquires a free slot, fills it and publishes it, a consumer acquires a ready slot, uses it and releases it back.
+ * Slots are reused, so there are no allocations once the contents of all slots were allocated.
+ * Closing the ring wakes all the waiting threads: producers get no more free slots, consumers get the remaining ready slots and then nullptr.
+ * \author tkornuta
+ * \tparam SlotType Type of the slot content.
+ */
+template<typename SlotType>
+class PrefetchRing {
+public:
+	/*!
+	 * Constructor. Allocates the slots.
+	 * @param capacity_ Number of slots (at least one).
+	 */
+	PrefetchRing(size_t capacity_) : slots(capacity_ > 0 ? capacity_ : 1), closed(false) {
+		for (size_t i = 0; i < slots.size(); i++)
+			free_slots.push_back(&slots[i]);
+	}
+
+	// The ring cannot be copied.
+	PrefetchRing(const PrefetchRing&) = delete;
+	PrefetchRing& operator=(const PrefetchRing&) = delete;
+
+	/*!
+	 * Returns the number of slots.
+	 */
+	size_t capacity() const {
+		return slots.size();
+	}
+
+	/*!
+	 * Waits for a free slot (producer side).
+	 * @return Pointer to the slot or nullptr if the ring was closed.
+	 */
+	SlotType* acquireFree() {
+		std::unique_lock<std::mutex> lock(mtx);
+		not_full.wait(lock, [this] { return closed || !free_slots.empty(); });
+		if (closed)
+			return nullptr;
+		SlotType* slot = free_slots.front();
+		free_slots.pop_front();
+		return slot;
+	}
+
+	/*!
+	 * Passes the filled slot to consumers (producer side).
+	 * @param slot_ Slot acquired with acquireFree().
+	 */
+	void publish(SlotType* slot_) {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			ready_slots.push_back(slot_);
+		}
+		not_empty.notify_one();
+	}
+
+	/*!
+	 * Waits for a ready slot (consumer side).
+	 * @return Pointer to the slot or nullptr if the ring was closed and there are no more ready slots.
+	 */
+	SlotType* acquireReady() {
+		std::unique_lock<std::mutex> lock(mtx);
+		not_empty.wait(lock, [this] { return closed || !ready_slots.empty(); });
+		if (ready_slots.empty())
+			return nullptr;
+		SlotType* slot = ready_slots.front();
+		ready_slots.pop_front();
+		return slot;
+	}
+
+	/*!
+	 * Returns the used slot back to the pool of free slots (consumer side).
+	 * @param slot_ Slot acquired with acquireReady().
+	 */
+	void release(SlotType* slot_) {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			free_slots.push_back(slot_);
+		}
+		not_full.notify_one();
+	}
+
+	/*!
+	 * Closes the ring and wakes all waiting threads.
+	 */
+	void close() {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			closed = true;
+		}
+		not_full.notify_all();
+		not_empty.notify_all();
+	}
+
+	/*!
+	 * Returns TRUE if the ring was closed.
+	 */
+	bool isClosed() {
+		std::lock_guard<std::mutex> lock(mtx);
+		return closed;
+	}
+
+	/*!
+	 * Reopens the ring and marks all slots as free. Must not be called while producers or consumers are using it.
+	 */
+	void reset() {
+		std::lock_guard<std::mutex> lock(mtx);
+		closed = false;
+		ready_slots.clear();
+		free_slots.clear();
+		for (size_t i = 0; i < slots.size(); i++)
+			free_slots.push_back(&slots[i]);
+	}
+
+private:
+	/// Slots.
+	std::vector<SlotType> slots;
+
+	/// Queue of free slots.
+	std::deque<SlotType*> free_slots;
+
+	/// Queue of ready slots (in the order of publishing).
+	std::deque<SlotType*> ready_slots;
+
+	/// Flag denoting that the ring was closed.
+	bool closed;
+
+	/// Mutex protecting the queues.
+	std::mutex mtx;
+
+	/// Condition variable signalled when a slot becomes free.
+	std::condition_variable not_full;
+
+	/// Condition variable signalled when a slot becomes ready.
+	std::condition_variable not_empty;
+};
+
+} /* namespace utils */
+} /* namespace mic */
+
+#endif /* SRC_UTILS_PREFETCHRING_HPP_ */
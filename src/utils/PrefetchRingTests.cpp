@@ -0,0 +1,145 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: PrefetchRingTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include <utils/PrefetchRing.hpp>
+
+
+/*!
+ * Tests whether slots are passed in the order of publishing and reused.
+ */
+TEST(PrefetchRing, PublishAndRelease) {
+	mic::utils::PrefetchRing<int> ring(3);
+	ASSERT_EQ(ring.capacity(), 3);
+
+	int* a = ring.acquireFree();
+	int* b = ring.acquireFree();
+	ASSERT_NE(a, b);
+	*a = 1;
+	*b = 2;
+	ring.publish(b);
+	ring.publish(a);
+
+	ASSERT_EQ(ring.acquireReady(), b);
+	ASSERT_EQ(ring.acquireReady(), a);
+	ring.release(a);
+	ring.release(b);
+
+	// All three slots are free again - and no other slots are created.
+	int* c = ring.acquireFree();
+	int* d = ring.acquireFree();
+	int* e = ring.acquireFree();
+	ASSERT_TRUE((c != d) && (d != e) && (c != e));
+	ASSERT_TRUE((a == c) || (a == d) || (a == e));
+	ASSERT_TRUE((b == c) || (b == d) || (b == e));
+
+	// Ring has at least one slot.
+	mic::utils::PrefetchRing<int> minimal(0);
+	ASSERT_EQ(minimal.capacity(), 1);
+}
+
+
+/*!
+ * Tests whether closing the ring returns the remaining ready slots and then nullptr.
+ */
+TEST(PrefetchRing, CloseDrainsReadySlots) {
+	mic::utils::PrefetchRing<int> ring(2);
+	int* a = ring.acquireFree();
+	ring.publish(a);
+	ring.close();
+	ASSERT_TRUE(ring.isClosed());
+
+	ASSERT_EQ(ring.acquireFree(), nullptr);
+	ASSERT_EQ(ring.acquireReady(), a);
+	ASSERT_EQ(ring.acquireReady(), nullptr);
+
+	// Reset reopens the ring with all slots free.
+	ring.reset();
+	ASSERT_FALSE(ring.isClosed());
+	ASSERT_NE(ring.acquireFree(), nullptr);
+	ASSERT_NE(ring.acquireFree(), nullptr);
+}
+
+
+/*!
+ * Tests whether closing the ring wakes a producer waiting for a free slot and a consumer waiting for a ready one.
+ */
+TEST(PrefetchRing, CloseWakesWaitingThreads) {
+	mic::utils::PrefetchRing<int> ring(1);
+	int* slot = ring.acquireFree();
+	ASSERT_NE(slot, nullptr);
+
+	std::atomic<bool> producer_done(false), consumer_done(false);
+	int* producer_slot = slot;
+	int* consumer_slot = slot;
+	std::thread producer([&] { producer_slot = ring.acquireFree(); producer_done = true; });
+	std::thread consumer([&] { consumer_slot = ring.acquireReady(); consumer_done = true; });
+
+	// Both threads are blocked - there are no free nor ready slots.
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_FALSE(producer_done);
+	EXPECT_FALSE(consumer_done);
+
+	ring.close();
+	producer.join();
+	consumer.join();
+	ASSERT_EQ(producer_slot, nullptr);
+	ASSERT_EQ(consumer_slot, nullptr);
+}
+
+
+/*!
+ * Tests passing a sequence of values from a producer thread to the consumer through a small ring.
+ */
+TEST(PrefetchRing, ProducerConsumer) {
+	const int N = 1000;
+	mic::utils::PrefetchRing<int> ring(2);
+	std::thread producer([&] {
+		for (int i = 0; i < N; i++) {
+			int* slot = ring.acquireFree();
+			*slot = i;
+			ring.publish(slot);
+		}//: for
+		ring.close();
+	});
+
+	int expected = 0;
+	while (int* slot = ring.acquireReady()) {
+		EXPECT_EQ(*slot, expected++);
+		ring.release(slot);
+	}//: while
+	producer.join();
+	ASSERT_EQ(expected, N);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
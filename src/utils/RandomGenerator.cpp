@@ -15,72 +15,59 @@
  */
 /*!
  * \file Random.cpp
-* \brief Contains definition of methods of a random generator singleton.
+* \brief Contains definition of methods of a per-thread random generator.
   * \author tkornut
  * \date Dec 24, 2015
  */
 
 #include  <utils/RandomGenerator.hpp>
 
-#include <logger/Log.hpp>
-
 namespace mic {
 namespace utils {
 
-// Init generator instance - as NULL.
-boost::atomic<RandomGenerator*> RandomGenerator::instance_(NULL);
+// Init stream counter.
+std::atomic<uint64_t> RandomGenerator::next_stream(0);
+
 
-// Initilize mutex.
-boost::mutex RandomGenerator::instantiation_mutex;
+std::atomic<uint64_t>& RandomGenerator::baseSeed() {
+	static std::atomic<uint64_t> seed(((uint64_t)std::random_device()() << 32) ^ std::random_device()());
+	return seed;
+}
 
 
 RandomGenerator* RandomGenerator::getInstance() {
-	// Try to load the instance - first check.
-	RandomGenerator* tmp = instance_.load(boost::memory_order_consume);
-	// If instance does not exist.
-	if (!tmp) {
-		// Enter critical section.
-		boost::mutex::scoped_lock guard(instantiation_mutex);
-		// Try to load the instance - second check.
-		tmp = instance_.load(boost::memory_order_consume);
-		// If still does not exist - create new instance.
-		if (!tmp) {
-			tmp = new RandomGenerator;
-			instance_.store(tmp, boost::memory_order_release);
-		}//: if
-		// Exit critical section.
-	}//: if
-	// Return instance.
-	return tmp;
+	// Every thread creates its own instance at first access - no locking required.
+	static thread_local RandomGenerator instance;
+	return &instance;
+}
+
+
+void RandomGenerator::setSeed(uint64_t seed_) {
+	// Create the generator of the calling thread first - its constructor takes a stream too.
+	RandomGenerator* instance = getInstance();
+	baseSeed().store(seed_);
+	next_stream.store(0);
+	// Reseed the generator of the calling thread.
+	instance->seed(seed_, next_stream.fetch_add(1));
 }
 
 
 RandomGenerator::RandomGenerator() :
-		rng_mt19937_64(rd()),
 		uniform_int_dist(0, RAND_MAX),
 		uniform_real_dist(0, 1),
 		normal_real_dist(0, 1)
 {
-	// TODO Auto-generated constructor stub
-
+	seed(baseSeed().load(), next_stream.fetch_add(1));
 }
 
 
-uint64_t RandomGenerator::uniRandInt(int min, int max) {
-	LOG(LTRACE)<<"uniRandInt";
-	std::uniform_int_distribution<> dist(min, max);
-	return dist(rng_mt19937_64);
-    //return uniform_int_dist(rng_mt19937_64);
-}
-
-double RandomGenerator::uniRandReal(double min, double max) {
-	LOG(LTRACE)<<"uniRandReal";
-    return (uniform_real_dist(rng_mt19937_64) + min)/(max - min);
-}
-
-double RandomGenerator::normRandReal(double mean, double variance) {
-	LOG(LTRACE)<<"normRandReal";
-    return (normal_real_dist(rng_mt19937_64) * variance + mean);
+void RandomGenerator::seed(uint64_t seed_, uint64_t stream_) {
+	stream_index = stream_;
+	// Mix seed and stream, so generators of different streams have unrelated states.
+	std::seed_seq seq{(uint32_t)seed_, (uint32_t)(seed_ >> 32), (uint32_t)stream_, (uint32_t)(stream_ >> 32)};
+	rng_mt19937_64.seed(seq);
+	// Drop the cached values.
+	normal_real_dist.reset();
 }
 
 
@@ -15,7 +15,7 @@
  */
 /*!
  * \file RandomGenerator.hpp
- * \brief Contains declaration of a random generator singleton.
+ * \brief Contains declaration of a random generator - one instance (stream) per thread.
  * \author tkornuta
  * \date Dec 24, 2015
  */
@@ -23,77 +23,136 @@
 #ifndef SRC_DATA_UTILS_RANDOMGENERATOR_HPP_
 #define SRC_DATA_UTILS_RANDOMGENERATOR_HPP_
 
-#include <boost/atomic.hpp>
-#include <boost/thread/mutex.hpp>
-
 #include <random>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib> // RAND_MAX
 
 namespace mic {
 namespace utils {
 
 /*!
- * \brief Random generator - defined in the form of a singleton, with double-checked locking pattern (DCLP) based access to instance.
+ * \brief Random generator - every thread has its own instance with an independent stream, so the access is lock-free and there are no data races on the generator state.
+ * Streams are derived from a common base seed and consecutive stream indices assigned to threads at their first access to the generator.
  * \author tkornuta
  */
 class RandomGenerator {
 public:
 
 	/*!
-	 * Method for accessing the object instance, with double-checked locking optimization.
-	 * @return Instance of ApplicationState singleton.
+	 * Method for accessing the instance of the calling thread (created at first access).
+	 * @return Instance of RandomGenerator belonging to the calling thread.
 	 */
 	static RandomGenerator* getInstance();
 
+	/*!
+	 * Sets the base seed and resets the counter of streams, then reseeds the generator of the calling thread with a new stream.
+	 * Generators of other threads that already exist are not changed.
+	 * @param seed_ Base seed.
+	 */
+	static void setSeed(uint64_t seed_);
+
+	/*!
+	 * Reseeds the generator.
+	 * @param seed_ Base seed.
+	 * @param stream_ Index of the stream.
+	 */
+	void seed(uint64_t seed_, uint64_t stream_);
 
 	/*!
-	 * Return a random integer from range <0, RAND_MAX> - uniform distribution.
+	 * Returns index of the stream used by the generator.
+	 * @return Index of the stream.
+	 */
+	uint64_t stream() const {
+		return stream_index;
+	}
+
+	/*!
+	 * Return a random integer from range <min, max> - uniform distribution.
+	 * @param min Min value.
+	 * @param max Max value.
 	 * @return Random integer.
 	 */
-	uint64_t uniRandInt(int min = 0, int max = RAND_MAX);
+	uint64_t uniRandInt(int min = 0, int max = RAND_MAX) {
+		return uniform_int_dist(rng_mt19937_64, std::uniform_int_distribution<>::param_type(min, max));
+	}
 
 	/*!
-	 * Return a random real number from range <min, max> - uniform distribution.
+	 * Return a random real number from range <min, max) - uniform distribution.
 	 * @param min Min value.
 	 * @param max Max value.
 	 * @return Random real value.
 	 */
-	double uniRandReal(double min = 0, double max = 1);
+	double uniRandReal(double min = 0, double max = 1) {
+		return min + uniform_real_dist(rng_mt19937_64) * (max - min);
+	}
 
 	/*!
 	 * Return a random real number - normal distribution.
 	 * @param mean Mean.
-	 * @param variance Variance.
+	 * @param variance Variance (used as scale of the distribution).
 	 * @return Random real value.
 	 */
-	double normRandReal(double mean = 0, double variance = 1);
+	double normRandReal(double mean = 0, double variance = 1) {
+		return normal_real_dist(rng_mt19937_64) * variance + mean;
+	}
 
-private:
-    /*!
-     * Private instance - accessed as atomic operation.
-     */
-	static boost::atomic<RandomGenerator*> instance_;
+	/*!
+	 * Fills memory with random numbers from range <min, max) - uniform distribution.
+	 * @tparam T Type of elements (float or double).
+	 * @param data_ Pointer to data.
+	 * @param size_ Number of elements.
+	 * @param min_ Min value.
+	 * @param max_ Max value.
+	 */
+	template<typename T>
+	void fillUniform(T* data_, size_t size_, T min_ = 0, T max_ = 1) {
+		std::uniform_real_distribution<T> dist(min_, max_);
+		for (size_t i = 0; i < size_; i++)
+			data_[i] = dist(rng_mt19937_64);
+	}
 
 	/*!
-	 * Mutex used for instantiation of the instance.
+	 * Fills memory with random numbers with a normal distribution.
+	 * @tparam T Type of elements (float or double).
+	 * @param data_ Pointer to data.
+	 * @param size_ Number of elements.
+	 * @param mean_ Mean.
+	 * @param stddev_ Standard deviation.
 	 */
-	static boost::mutex instantiation_mutex;
+	template<typename T>
+	void fillNormal(T* data_, size_t size_, T mean_ = 0, T stddev_ = 1) {
+		std::normal_distribution<T> dist(mean_, stddev_);
+		for (size_t i = 0; i < size_; i++)
+			data_[i] = dist(rng_mt19937_64);
+	}
 
+private:
 	/*!
-	 * Private constructor. Initialize pseudo-random generator and distributions parameters.
+	 * Returns reference to the base seed - initially taken from random device.
+	 * @return Reference to the base seed.
 	 */
-	RandomGenerator();
+	static std::atomic<uint64_t>& baseSeed();
 
 	/*!
-	 * Random device used for generation of random numbers.
+	 * Counter used for assigning consecutive streams to threads.
 	 */
-	std::random_device rd;
+	static std::atomic<uint64_t> next_stream;
+
+	/*!
+	 * Private constructor. Seeds the generator with the base seed and a new stream.
+	 */
+	RandomGenerator();
+
+	/// Index of the stream.
+	uint64_t stream_index;
 
 	/*!
-	 *  Mersenne Twister pseudo-random generator of 32-bit numbers with a state size of 19937 bits.
+	 *  Mersenne Twister pseudo-random generator of 64-bit numbers with a state size of 19937 bits.
 	 */
 	std::mt19937_64 rng_mt19937_64;
 
-	/// Uniform distribution from 0 to RAND_MAX (integers).
+	/// Uniform distribution of integers (parameters passed on every draw).
 	std::uniform_int_distribution<> uniform_int_dist;
 
 	/// Uniform distribution from 0 to 1 (real values).
@@ -105,7 +164,7 @@ private:
 };
 
 /*!
- * \brief Macro returning random generator instance.
+ * \brief Macro returning random generator instance of the calling thread.
  * \author tkornuta
  */
 #define RAN_GEN mic::utils::RandomGenerator::getInstance()
@@ -0,0 +1,192 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: RandomGeneratorTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 16, 2026
+ *
+ * Copyright (c) 2026, IBM Corporation. All rights reserved.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <thread>
+#include <cmath>
+
+#include <utils/RandomGenerator.hpp>
+
+/*!
+ * Draws a sequence of values using all the methods of the generator of the calling thread.
+ * @param size_ Number of draws of every kind.
+ */
+std::vector<double> drawSequence(size_t size_) {
+	std::vector<double> values;
+	for (size_t i = 0; i < size_; i++) {
+		values.push_back(RAN_GEN->uniRandReal());
+		values.push_back((double)RAN_GEN->uniRandInt(0, 1000));
+		values.push_back(RAN_GEN->normRandReal());
+	}//: for
+	std::vector<float> block(size_);
+	RAN_GEN->fillUniform(block.data(), size_);
+	values.insert(values.end(), block.begin(), block.end());
+	RAN_GEN->fillNormal(block.data(), size_);
+	values.insert(values.end(), block.begin(), block.end());
+	return values;
+}
+
+
+/*!
+ * Tests whether setting the seed makes the draws reproducible.
+ */
+TEST(RandomGenerator, SetSeedReproducible) {
+	mic::utils::RandomGenerator::setSeed(42);
+	ASSERT_EQ(RAN_GEN->stream(), 0);
+	std::vector<double> first = drawSequence(50);
+
+	mic::utils::RandomGenerator::setSeed(42);
+	std::vector<double> second = drawSequence(50);
+	ASSERT_EQ(first, second);
+
+	// Other seed - other sequence.
+	mic::utils::RandomGenerator::setSeed(43);
+	std::vector<double> third = drawSequence(50);
+	ASSERT_NE(first, third);
+}
+
+
+/*!
+ * Tests whether every thread has its own generator with a different (yet reproducible) stream.
+ */
+TEST(RandomGenerator, ThreadStreams) {
+	const size_t threads = 4;
+	mic::utils::RandomGenerator::setSeed(7);
+	std::vector<double> main_values = drawSequence(20);
+
+	std::vector<std::vector<double> > values(threads);
+	std::vector<uint64_t> streams(threads);
+	std::vector<mic::utils::RandomGenerator*> instances(threads);
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < threads; t++)
+		workers.push_back(std::thread([&, t] {
+			instances[t] = RAN_GEN;
+			streams[t] = RAN_GEN->stream();
+			values[t] = drawSequence(20);
+		}));
+	for (auto& worker : workers)
+		worker.join();
+
+	for (size_t t = 0; t < threads; t++) {
+		ASSERT_NE(instances[t], RAN_GEN);
+		// Main thread uses stream 0.
+		ASSERT_NE(streams[t], 0);
+		ASSERT_NE(values[t], main_values);
+		for (size_t u = t + 1; u < threads; u++) {
+			ASSERT_NE(streams[t], streams[u]);
+			ASSERT_NE(values[t], values[u]);
+		}//: for
+	}//: for
+
+	// The sequence depends only on the seed and the stream.
+	for (size_t t = 0; t < threads; t++) {
+		RAN_GEN->seed(7, streams[t]);
+		ASSERT_EQ(drawSequence(20), values[t]);
+	}//: for
+}
+
+
+/*!
+ * Tests ranges and moments of uniform distributions.
+ */
+TEST(RandomGenerator, UniformMoments) {
+	mic::utils::RandomGenerator::setSeed(1234);
+	const size_t N = 100000;
+
+	std::vector<float> f(N);
+	RAN_GEN->fillUniform(f.data(), N, -2.0f, 3.0f);
+	std::vector<double> d(N);
+	RAN_GEN->fillUniform(d.data(), N, 10.0, 11.0);
+	double sum_f = 0, sum2_f = 0, sum_d = 0, sum2_d = 0;
+	for (size_t i = 0; i < N; i++) {
+		ASSERT_GE(f[i], -2.0f);
+		ASSERT_LT(f[i], 3.0f);
+		ASSERT_GE(d[i], 10.0);
+		ASSERT_LT(d[i], 11.0);
+		sum_f += f[i];
+		sum2_f += f[i] * f[i];
+		sum_d += d[i];
+		sum2_d += d[i] * d[i];
+	}//: for
+	// Mean (a+b)/2, variance (b-a)^2/12.
+	ASSERT_NEAR(sum_f / N, 0.5, 0.03);
+	ASSERT_NEAR(sum2_f / N - (sum_f / N) * (sum_f / N), 25.0 / 12.0, 0.05);
+	ASSERT_NEAR(sum_d / N, 10.5, 0.01);
+	ASSERT_NEAR(sum2_d / N - (sum_d / N) * (sum_d / N), 1.0 / 12.0, 0.005);
+
+	// Single draws.
+	bool min_drawn = false, max_drawn = false;
+	for (size_t i = 0; i < 1000; i++) {
+		double r = RAN_GEN->uniRandReal(1, 2);
+		ASSERT_GE(r, 1.0);
+		ASSERT_LT(r, 2.0);
+		uint64_t k = RAN_GEN->uniRandInt(3, 7);
+		ASSERT_GE(k, 3);
+		ASSERT_LE(k, 7);
+		min_drawn |= (k == 3);
+		max_drawn |= (k == 7);
+	}//: for
+	// Both ends of the range are included.
+	ASSERT_TRUE(min_drawn);
+	ASSERT_TRUE(max_drawn);
+}
+
+
+/*!
+ * Tests moments of normal distributions.
+ */
+TEST(RandomGenerator, NormalMoments) {
+	mic::utils::RandomGenerator::setSeed(4321);
+	const size_t N = 100000;
+
+	std::vector<float> f(N);
+	RAN_GEN->fillNormal(f.data(), N, 1.0f, 2.0f);
+	double sum = 0, sum2 = 0;
+	for (size_t i = 0; i < N; i++) {
+		ASSERT_TRUE(std::isfinite(f[i]));
+		sum += f[i];
+		sum2 += f[i] * f[i];
+	}//: for
+	const double mean = sum / N;
+	ASSERT_NEAR(mean, 1.0, 0.03);
+	ASSERT_NEAR(std::sqrt(sum2 / N - mean * mean), 2.0, 0.03);
+
+	sum = 0;
+	sum2 = 0;
+	for (size_t i = 0; i < N; i++) {
+		double r = RAN_GEN->normRandReal(-3, 0.5);
+		sum += r;
+		sum2 += r * r;
+	}//: for
+	ASSERT_NEAR(sum / N, -3.0, 0.01);
+	ASSERT_NEAR(std::sqrt(sum2 / N - (sum / N) * (sum / N)), 0.5, 0.01);
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}